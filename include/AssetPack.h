@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include "EngineBackend.h"
+
+/*
+ * AssetPack.h
+ *
+ * Read-only archive of engine assets (shaders, fonts, meshes) in one file.
+ * The pack is memory-mapped once; lookups binary-search a sorted index, so
+ * resolving an asset costs no file opens and no directory scans.
+ *
+ * Layout (little-endian, offsets from the start of the file):
+ *   PackHeader
+ *   PackEntry[entryCount]        sorted by path (byte-wise)
+ *   path strings                 referenced by PackEntry::pathOffset
+ *   entry data                   each blob aligned to DATA_ALIGNMENT
+ *
+ * Entries are stored raw or LZ-compressed, whichever is smaller.
+ */
+
+class AssetPack {
+public:
+    static constexpr uint32_t MAGIC = 0x4B505341;  // "ASPK"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t DATA_ALIGNMENT = 16;
+
+    enum EntryFlags : uint32_t {
+        ENTRY_COMPRESSED = 1u << 0
+    };
+
+    struct PackHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t reserved;
+        uint64_t indexOffset;
+        uint64_t stringsOffset;
+    };
+
+    struct PackEntry {
+        uint64_t dataOffset;
+        uint64_t storedSize;
+        uint64_t originalSize;
+        uint32_t pathOffset;
+        uint32_t pathLength;
+        uint32_t flags;
+        uint32_t reserved;
+    };
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file.isOpen(); }
+
+    bool contains(std::string_view path) const;
+    size_t getEntryCount() const { return entryCount; }
+
+    // Raw entries come back as a view into the mapping; compressed entries are
+    // inflated into scratch and the view points there. nullopt if missing or corrupt.
+    std::optional<std::string_view> read(std::string_view path, std::vector<uint8_t>& scratch) const;
+
+    // Packs files into outputPath. Each pair is (path inside the pack, file on disk).
+    static bool build(const std::string& outputPath,
+                      const std::vector<std::pair<std::string, std::string>>& files,
+                      bool compress = true);
+
+    // LZ77 block codec used for compressed entries (byte-oriented, LZ4-style sequences)
+    static std::vector<uint8_t> compress(const uint8_t* data, size_t size);
+    static bool decompress(const uint8_t* data, size_t size, uint8_t* output, size_t outputSize);
+
+    // Pack paths always use forward slashes
+    static std::string normalizePath(std::string_view path);
+
+private:
+    const PackEntry* find(std::string_view path) const;
+    std::string_view entryPath(const PackEntry& entry) const;
+
+    MappedFile file;
+    const PackEntry* entries = nullptr;
+    size_t entryCount = 0;
+    std::string_view strings;
+};
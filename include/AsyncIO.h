@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+/*
+ * AsyncIO.h
+ *
+ * Batched asynchronous file reads and writes. On Linux the requests go through
+ * io_uring, so a whole batch costs one submission syscall; everywhere else, or
+ * when the kernel refuses io_uring, they run as blocking calls on the shared
+ * I/O thread pool.
+ *
+ * Completion callbacks never run on a kernel or worker thread: they are
+ * delivered from poll()/wait()/waitAll() on the calling thread. If one throws,
+ * the rest of that delivery still runs and the first exception is rethrown.
+ */
+
+enum class IOOperation {
+    Read,
+    Write
+};
+
+struct IORequest {
+    IOOperation operation = IOOperation::Read;
+    std::string path;
+    uint8_t* buffer = nullptr;   // Destination for reads, source for writes
+    size_t length = 0;
+    uint64_t offset = 0;
+    int registeredBuffer = -1;   // Index from registerBuffers(), or -1
+    bool truncate = false;       // Writes only: truncate the file when opening it
+    uint64_t userData = 0;
+};
+
+struct IOCompletion {
+    uint64_t userData;
+    IOOperation operation;
+    size_t bytesTransferred;
+    int error;                   // 0 on success, otherwise an errno value
+};
+
+class AsyncIO {
+public:
+    using CompletionCallback = std::function<void(const IOCompletion&)>;
+    using FileCallback = std::function<void(const std::string& path, std::vector<uint8_t>&& data, bool success)>;
+
+    static AsyncIO& getInstance();
+
+    bool isUsingIOUring() const;
+
+    // Pins buffers for fixed reads/writes (IORING_REGISTER_BUFFERS). Requests
+    // refer to them by index; the thread-pool backend just uses the pointers.
+    bool registerBuffers(const std::vector<std::pair<uint8_t*, size_t>>& buffers);
+    void unregisterBuffers();
+
+    // Queues every request in the batch with a single submission and returns
+    // the number queued. The callback fires once per request.
+    size_t submit(const std::vector<IORequest>& batch, CompletionCallback callback);
+
+    size_t poll();                        // Delivers finished completions without blocking
+    size_t wait(size_t minCompletions = 1);
+    void waitAll();
+    size_t pending() const;
+
+    // Whole-file helpers built on submit()
+    void readFiles(const std::vector<std::string>& paths, FileCallback callback);
+    void writeFile(const std::string& path, std::shared_ptr<const std::vector<uint8_t>> data,
+                   std::function<void(bool success)> callback);
+
+private:
+    AsyncIO();
+    ~AsyncIO();
+    AsyncIO(const AsyncIO&) = delete;
+    AsyncIO& operator=(const AsyncIO&) = delete;
+
+    struct Operation;
+    class Ring;
+
+    bool openFile(Operation& op);
+    // Pushes queued operations into the ring and submits them. Returns a
+    // transient errno when the kernel took none for now; hard errors fail them
+    int flushQueued();
+    // Completes every pushed-but-unsubmitted and queued operation with error
+    void failUnsubmitted(int error);
+    void runBlocking(Operation* op);
+    size_t deliver(size_t minCompletions, bool block);
+
+    std::unique_ptr<Ring> ring;
+    std::vector<std::pair<uint8_t*, size_t>> registeredBuffers;
+
+    // io_uring backend: operations waiting for a free submission slot
+    std::deque<Operation*> queued;
+
+    // Thread-pool backend completions, handed over from the workers
+    std::deque<Operation*> finished;
+    std::condition_variable finishedCondition;
+    // A thread is blocked in the kernel for ring completions, without ioMutex.
+    // Only that thread reaps the ring meanwhile; others wait on finishedCondition
+    bool ringWaiting = false;
+
+    mutable std::mutex ioMutex;
+    std::atomic<size_t> inFlight;
+};
@@ -5,7 +5,9 @@ class Body {
 public:
     double mass;
     Vector position, velocity, acceleration;
-    // (Later) Add name, color, mesh, etc.
+    float radius;  // Scale applied to the body's mesh when rendering
+    Vector color;  // RGB in [0, 1]
+    // (Later) Add name, mesh, etc.
 
     Body(double mass = 1.0, 
          const Vector& pos = Vector(), 
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <mutex>
+#include <type_traits>
+#include "EngineBackend.h"
+
+/*
+ * DerivedAssetCache.h
+ *
+ * Persistent, content-addressed store for assets derived from other data:
+ * baked meshes, font atlases, GL program binaries. Entries are named by a
+ * hash of everything that went into producing them (source bytes, generator
+ * parameters, generator version), so a changed input simply produces a new
+ * key and stale entries age out under the size cap.
+ *
+ * Entries are written to a temporary file and renamed into place, and carry
+ * a checksum so a truncated or corrupt entry reads as a miss.
+ */
+
+class DerivedAssetCache {
+public:
+    // Accumulates the inputs of a derived asset into a 128-bit key
+    class KeyBuilder {
+    public:
+        explicit KeyBuilder(std::string_view kind);
+        KeyBuilder& add(const void* data, size_t size);
+        KeyBuilder& add(std::string_view text);
+        template<typename T, typename = std::enable_if_t<std::is_trivially_copyable_v<T>>>
+        KeyBuilder& add(const T& value) { return add(&value, sizeof(T)); }
+        std::string finish() const;  // Hex digest, used as the entry file name
+
+    private:
+        uint64_t lanes[2];
+    };
+
+    static DerivedAssetCache& getInstance();
+
+    void setDirectory(const std::string& path);
+    void setMaxSize(size_t bytes);
+
+    // Maps the entry for key into file; false on a miss or a corrupt entry
+    bool load(const std::string& key, MappedFile& file, std::string_view& payload);
+    bool store(const std::string& key, const void* data, size_t size);
+    void invalidate(const std::string& key);
+    void clear();
+
+    // Deletes least recently used entries until the cache fits in maxSize
+    void enforceSizeCap();
+    size_t getTotalSize() const;
+
+    static uint64_t checksum(const void* data, size_t size);
+
+private:
+    DerivedAssetCache();
+    ~DerivedAssetCache();
+    DerivedAssetCache(const DerivedAssetCache&) = delete;
+    DerivedAssetCache& operator=(const DerivedAssetCache&) = delete;
+
+    struct EntryHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t payloadSize;
+        uint64_t payloadChecksum;
+    };
+
+    std::string entryPath(const std::string& key) const;
+
+    std::string directory;
+    size_t maxSize;
+    mutable std::mutex cacheMutex;
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <array>
 #include <fstream>
 #include <sstream>
 #include <chrono>
@@ -13,6 +14,15 @@
 #include <thread>
 #include <atomic>
 #include <condition_variable>
+#include <future>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <string_view>
+#include <vector>
+#include "Histogram.h"
+#include "InstrumentedMutex.h"
 
 namespace fs = std::filesystem;
 
@@ -46,6 +56,37 @@ enum class CachePolicy {
     LFU     // Least Frequently Used
 };
 
+// Resource classes with their own memory budget (resource_management.memory)
+enum class ResourceClass {
+    Texture,
+    Mesh,
+    Shader
+};
+
+// Snapshot of a cache's occupancy, summed over all shards
+struct CacheStats {
+    size_t entries = 0;
+    size_t entryCapacity = 0;
+    size_t bytes = 0;
+    size_t byteBudget = 0;    // 0 when the cache only limits entry count
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+    size_t rejected = 0;      // Entries larger than the whole byte budget, never stored
+    size_t coalesced = 0;     // getOrLoad calls that joined a load already in flight
+};
+
+// Access pattern hints for memory-mapped files (madvise on POSIX)
+enum class AccessHint {
+    Normal,
+    Sequential,
+    Random,
+    WillNeed
+};
+
+class ThreadPool;
+struct ProfileZone;
+
 class Logger {
 public:
     static Logger& getInstance();
@@ -62,40 +103,170 @@ private:
 
     std::ofstream logFile;
     LogLevel currentLevel;
-    mutable std::mutex logMutex;
+    mutable InstrumentedMutex logMutex{"Logger"};
     std::string getTimestamp();
     std::string getLevelString(LogLevel level);
 };
 
+// Sharded, thread-safe cache. Entries are handed out as shared handles so a
+// lookup never copies T, and an entry evicted while in use stays alive until
+// the last handle goes away. Every policy evicts in O(1):
+//   LRU  - one recency list per shard, hits move the entry to the front
+//   FIFO - one insertion-order list per shard, hits leave the order alone
+//   LFU  - frequency buckets in ascending order, ties broken by recency
+// Each shard owns maxSize / shardCount slots, so with more than one shard the
+// cache evicts per shard rather than globally.
+//
+// A cache built with a cost function also keeps the summed cost (in bytes) of
+// its entries under maxBytes. The total is tracked across all shards: a put
+// first evicts from its own shard, then from the others if that was not
+// enough, so the budget can be exceeded briefly while concurrent puts trim.
+// Entries costing more than maxBytes are handed back without being stored.
+//
+// getOrLoad coalesces concurrent misses for a key into a single loader call
+// on a worker pool; every caller shares the same future. Loaders should poll
+// the cancellation flag they are given during long reads or parses.
 template<typename T>
 class Cache {
 public:
-    Cache(size_t maxSize, CachePolicy policy = CachePolicy::LRU);
-    void put(const std::string& key, const T& value);
-    bool get(const std::string& key, T& value);
-    void remove(const std::string& key);
+    using Handle = std::shared_ptr<const T>;
+    using CostFunction = std::function<size_t(const T&)>;
+    using Loader = std::function<Handle(const std::atomic<bool>& cancelled)>;
+
+    // shardCount == 0 picks a count based on maxSize (small caches get one shard)
+    Cache(size_t maxSize, CachePolicy policy = CachePolicy::LRU, size_t shardCount = 0);
+    Cache(size_t maxSize, size_t maxBytes, CostFunction cost,
+          CachePolicy policy = CachePolicy::LRU, size_t shardCount = 0);
+    ~Cache();
+    Handle put(std::string_view key, T value);
+    Handle put(std::string_view key, Handle value);
+    Handle get(std::string_view key);
+    // Resolves to nullptr if the loader fails or the load is cancelled;
+    // exceptions thrown by the loader are rethrown from the future
+    std::shared_future<Handle> getOrLoad(std::string_view key, Loader loader);
+    std::shared_future<Handle> getOrLoad(std::string_view key, Loader loader, ThreadPool& pool);
+    // Cancels the in-flight load for key for every caller waiting on it
+    bool cancelLoad(std::string_view key);
+    bool contains(std::string_view key) const;
+    void remove(std::string_view key);
     void clear();
     size_t size() const;
+    size_t getHitCount() const;
+    size_t getMissCount() const;
+    CacheStats getStats() const;
 
 private:
     struct CacheEntry {
-        T value;
-        std::chrono::system_clock::time_point lastAccess;
-        size_t accessCount;
+        std::string key;
+        Handle value;
+        size_t cost;
+    };
+    using EntryList = std::list<CacheEntry>;
+
+    struct Bucket {
+        size_t frequency;
+        EntryList entries;  // Most recently touched entry at the front
+    };
+    using BucketList = std::list<Bucket>;
+
+    struct Slot {
+        typename BucketList::iterator bucket;
+        typename EntryList::iterator entry;
+    };
+
+    struct PendingLoad {
+        std::string key;
+        std::shared_future<Handle> future;
+        std::atomic<bool> cancelled{false};
     };
 
-    std::unordered_map<std::string, CacheEntry> cache;
+    struct Shard {
+        mutable InstrumentedMutex mutex{"Cache::Shard"};
+        BucketList buckets;  // Ascending frequency; LRU and FIFO only ever use one bucket
+        // Keys are views into CacheEntry::key, which list splicing never moves
+        std::unordered_map<std::string_view, Slot> index;
+        // Loads in flight, keyed by views into PendingLoad::key
+        std::unordered_map<std::string_view, std::shared_ptr<PendingLoad>> loading;
+        size_t capacity = 0;
+        size_t bytes = 0;
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+        size_t rejected = 0;
+        size_t coalesced = 0;
+    };
+
+    static constexpr size_t MAX_SHARDS = 16;
+    static constexpr size_t MIN_ENTRIES_PER_SHARD = 64;
+
+    Shard& shardFor(std::string_view key) const;
+    void insert(Shard& shard, std::string_view key, Handle value, size_t cost);
+    void touch(Shard& shard, Slot& slot);
+    void evict(Shard& shard);
+    // Evicts from the other shards until the total is back under budget; call without any shard locked
+    void trimOtherShards(const Shard& current);
+    void runLoad(Shard& shard, const std::shared_ptr<PendingLoad>& load, const Loader& loader,
+                 std::promise<Handle>& promise);
+    void erase(Shard& shard, typename std::unordered_map<std::string_view, Slot>::iterator it);
+
+    std::vector<std::unique_ptr<Shard>> shards;
     size_t maxSize;
+    size_t maxBytes;
+    size_t byteBudget;  // maxBytes, or SIZE_MAX when unlimited
+    std::atomic<size_t> totalBytes{0};
+    CostFunction costFunction;
     CachePolicy policy;
-    mutable std::mutex cacheMutex;
-    void evict();
+};
+
+// Read-only memory mapping of a whole file. data()/view() point straight into
+// the mapping and stay valid until the MappedFile is closed or destroyed, so
+// loaders can parse in place without copying the file into a buffer.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path, AccessHint hint = AccessHint::Normal);
+    void close();
+    // Applies a hint to [offset, offset + length); length 0 means to the end
+    void advise(AccessHint hint, size_t offset = 0, size_t length = 0) const;
+
+    bool isOpen() const { return opened; }
+    const uint8_t* data() const { return mapping; }
+    size_t size() const { return length; }
+    std::string_view view() const { return {reinterpret_cast<const char*>(mapping), length}; }
+    std::string_view view(size_t offset, size_t count) const;
+
+private:
+    const uint8_t* mapping = nullptr;
+    size_t length = 0;
+    bool opened = false;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
 };
 
 class FileSystem {
 public:
     static FileSystem& getInstance();
     bool loadFile(const std::string& path, std::vector<uint8_t>& data);
+    bool mapFile(const std::string& path, MappedFile& file, AccessHint hint = AccessHint::Sequential);
     bool saveFile(const std::string& path, const std::vector<uint8_t>& data);
+    // Batched reads and writes through AsyncIO (io_uring where the kernel
+    // allows, the I/O pool otherwise). Callbacks run from AsyncIO::poll(),
+    // wait() or waitAll() on the polling thread
+    void loadFilesAsync(const std::vector<std::string>& paths,
+                        std::function<void(const std::string& path, std::vector<uint8_t>&& data, bool success)> callback);
+    void saveFileAsync(const std::string& path, std::shared_ptr<const std::vector<uint8_t>> data,
+                       std::function<void(bool success)> callback = nullptr);
+    // Reads every path as one batch and waits for it; false if any read
+    // failed. Not from an I/O pool worker: the fallback backend runs there
+    bool loadFiles(const std::vector<std::string>& paths, std::vector<std::vector<uint8_t>>& data);
     bool fileExists(const std::string& path);
     std::string getFileExtension(const std::string& path);
     std::string getFileName(const std::string& path);
@@ -116,26 +287,102 @@ public:
     template<class F, class... Args>
     void enqueue(F&& f, Args&&... args);
     void waitForCompletion();
+    size_t getThreadCount() const { return workers.size(); }
+    // Splits [0, count) into up to getThreadCount() + 1 ranges of at least
+    // minShare items and runs body(begin, end) on each, one on the calling
+    // thread, returning when all are done. If a share throws, the exception is
+    // rethrown once every share has finished. Never call it from this pool's
+    // own workers: they would wait on tasks queued behind them
+    void parallelFor(size_t count, size_t minShare, const std::function<void(size_t, size_t)>& body);
+
+    // Shared pool for file and asset loading, sized by optimization.threading.io_threads
+    static ThreadPool& getIOPool();
+    // Shared pool for per-frame render work such as culling, sized by
+    // optimization.threading.render_threads; the render thread helps too
+    static ThreadPool& getRenderPool();
 
 private:
     std::vector<std::thread> workers;
     std::queue<std::function<void()>> tasks;
-    std::mutex queueMutex;
-    std::condition_variable condition;
+    InstrumentedMutex queueMutex{"ThreadPool"};
+    std::condition_variable_any condition;
     std::atomic<bool> stop;
 };
 
+// Typed publish/subscribe bus. An event is any copyable struct and its type
+// is the channel, resolved to a small index once per type, so emitting does
+// no string hashing. Handler lists are immutable and replaced copy-on-write,
+// so emit() takes no lock and handlers may freely emit, subscribe or
+// unsubscribe. A handler removed while another thread is emitting may still
+// run once on that thread.
+//
+//   auto token = bus.subscribe<BodyAdded>([](const BodyAdded& e) { ... });
+//   bus.emit(BodyAdded{id});   // handlers run now, on this thread
+//   bus.post(BodyAdded{id});   // handlers run in the next dispatchDeferred()
+//   bus.unsubscribe(token);
 class EventSystem {
 public:
-    using EventCallback = std::function<void(const void*)>;
-    
-    void subscribe(const std::string& eventName, EventCallback callback);
-    void unsubscribe(const std::string& eventName, EventCallback callback);
-    void emit(const std::string& eventName, const void* data = nullptr);
+    using Subscription = uint64_t;  // 0 is never issued
+
+    EventSystem();
+    ~EventSystem();
+    EventSystem(const EventSystem&) = delete;
+    EventSystem& operator=(const EventSystem&) = delete;
+
+    // Engine-wide bus; MainWindow dispatches its deferred events at the start of each frame
+    static EventSystem& getEngineEvents();
+
+    template<typename Event>
+    Subscription subscribe(std::function<void(const Event&)> handler);
+    void unsubscribe(Subscription token);
+
+    template<typename Event>
+    void emit(const Event& event) const;
+    // Queues a copy from any thread for delivery on the dispatching thread
+    template<typename Event>
+    void post(Event event);
+    // Delivers everything posted before the call, in order per event type.
+    // Events posted by the handlers wait for the next call. If a handler
+    // throws, the rest of that type's batch is dropped, the other types are
+    // still delivered and the first exception is rethrown at the end
+    void dispatchDeferred();
 
 private:
-    std::unordered_map<std::string, std::vector<EventCallback>> eventHandlers;
-    mutable std::mutex eventMutex;
+    static constexpr uint32_t TYPE_BITS = 6;
+    static constexpr uint32_t MAX_EVENT_TYPES = 1u << TYPE_BITS;
+
+    struct Handler {
+        Subscription token;
+        std::function<void(const void*)> call;
+    };
+    using HandlerList = std::vector<Handler>;
+
+    struct QueueBase {
+        virtual ~QueueBase() = default;
+        virtual bool hasPending() const = 0;
+        virtual void takePending() = 0;  // queueMutex held
+        virtual void dispatch(const EventSystem& bus) = 0;
+    };
+    template<typename Event>
+    struct Queue;
+
+    static uint32_t nextTypeId();
+    template<typename Event>
+    static uint32_t typeId();
+
+    Subscription addHandler(uint32_t type, std::function<void(const void*)> call);
+    void replaceHandlers(uint32_t type, const HandlerList* next);  // subscriptionMutex held
+    void deliver(uint32_t type, const void* event) const;
+
+    std::array<std::atomic<const HandlerList*>, MAX_EVENT_TYPES> handlers;
+    // Replaced lists are freed once no emit() is running
+    mutable std::atomic<uint32_t> activeEmits{0};
+    std::vector<const HandlerList*> retired;
+    uint64_t nextToken = 1;
+    InstrumentedMutex subscriptionMutex{"EventSystem"};
+
+    std::array<std::unique_ptr<QueueBase>, MAX_EVENT_TYPES> queues;
+    InstrumentedMutex queueMutex{"EventSystem::Queue"};
 };
 
 class PerformanceMonitor {
@@ -143,24 +390,112 @@ public:
     static PerformanceMonitor& getInstance();
     void startFrame();
     void endFrame();
+    // Operations may nest and may run on several threads at once; each thread
+    // keeps its own stack, and the pair is also recorded as a Profiler event
     void startOperation(const std::string& name);
     void endOperation(const std::string& name);
     double getFPS() const;
-    double getOperationTime(const std::string& name) const;
+    double getOperationTime(const std::string& name) const;  // Last duration in ms
+    // Submitted geometry; the full-detail counts are what the same draws would
+    // have cost at LOD 0, so the report can show what LOD selection saved
+    struct RenderStats {
+        uint32_t drawCalls = 0;
+        uint64_t triangles = 0;
+        uint64_t vertices = 0;
+        uint64_t fullDetailTriangles = 0;
+        uint64_t fullDetailVertices = 0;
+        uint64_t visibleObjects = 0;  // Passed culling
+        uint64_t culledObjects = 0;   // Outside the frustum
+        uint64_t occludedObjects = 0; // Rejected by occlusion culling
+    };
+    void addRenderStats(const RenderStats& stats);
     void reset();
 
+    // Percentiles over the rolling window (debug.profiling.histogram_window
+    // seconds). Metric names: "frame_time", "fps", "memory_usage",
+    // "allocations" (heap allocations per frame), "frame_arena" (FrameArena
+    // bytes per frame, in KB), "draw_calls", "triangles", "vertices",
+    // "visible_objects", "culled_objects", "occluded_objects" (per frame) or
+    // any operation name, e.g. "physics_time".
+    // Times are in ms, memory in MB.
+    struct MetricSummary {
+        uint64_t count = 0;
+        double p50 = 0.0;
+        double p90 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+    MetricSummary getMetricSummary(const std::string& metric) const;
+    // One line per metric in debug.profiling.metrics, then LOD savings, arena
+    // high-water marks and the most contended locks
+    std::string getReport() const;
+
+    static size_t getMemoryUsage();  // Resident set size in bytes, 0 if unknown
+
 private:
     PerformanceMonitor();
     ~PerformanceMonitor();
     PerformanceMonitor(const PerformanceMonitor&) = delete;
     PerformanceMonitor& operator=(const PerformanceMonitor&) = delete;
 
-    std::chrono::system_clock::time_point frameStart;
-    std::unordered_map<std::string, double> operationTimes;
-    mutable std::mutex monitorMutex;
-    double fps;
+    struct Operation {
+        explicit Operation(size_t windowSlots) : durations(windowSlots) {}
+        const ProfileZone* zone = nullptr;
+        std::atomic<uint64_t> lastDuration{0};  // Nanoseconds
+        Histogram durations;                    // Nanoseconds
+    };
+
+    struct OpenOperation {
+        Operation* operation;
+        uint64_t start;
+        uint32_t depth;
+    };
+
+    // Histograms sampled per frame or per sample interval, indexed by Metric;
+    // names and report units live in one table in EngineBackend.cpp, so
+    // recording, advancing, resetting and lookup cover every metric
+    enum Metric : size_t {
+        FRAME_TIME,        // Nanoseconds between endFrame calls
+        FPS,               // Frames per second x 1000
+        MEMORY_USAGE,      // Bytes
+        ALLOCATIONS,       // Heap allocations per frame
+        FRAME_ARENA,       // FrameArena bytes per frame
+        DRAW_CALLS,        // From here on, summed from RenderStats per frame
+        TRIANGLES,
+        VERTICES,
+        VISIBLE_OBJECTS,
+        CULLED_OBJECTS,
+        OCCLUDED_OBJECTS,
+        METRIC_COUNT
+    };
+    static constexpr size_t FIRST_RENDER_METRIC = DRAW_CALLS;
+    static size_t findMetric(const std::string& name);  // METRIC_COUNT when not sampled
+
+    Operation& lookupOperation(const std::string& name);
+    static std::vector<OpenOperation>& openOperations();  // Calling thread's stack
+    void sample(std::chrono::steady_clock::time_point now);
+
+    std::chrono::steady_clock::time_point frameStart;
+    std::chrono::steady_clock::time_point lastFrameEnd;
+    std::chrono::steady_clock::time_point lastSample;
+    std::chrono::nanoseconds sampleInterval;
+    size_t windowSlots;
+    std::vector<std::string> reportedMetrics;
+    int framesSinceSample;
+    std::array<std::unique_ptr<Histogram>, METRIC_COUNT> metrics;
+    // Render metrics since the last endFrame, indexed by Metric
+    std::array<std::atomic<uint64_t>, METRIC_COUNT> pending{};
+    // Since reset(), for the LOD savings line
+    std::atomic<uint64_t> totalTriangles{0};
+    std::atomic<uint64_t> totalVertices{0};
+    std::atomic<uint64_t> totalFullDetailTriangles{0};
+    std::atomic<uint64_t> totalFullDetailVertices{0};
+    // Nodes are never erased, so threads may cache Operation pointers
+    std::unordered_map<std::string, std::unique_ptr<Operation>> operations;
+    mutable InstrumentedMutex monitorMutex{"PerformanceMonitor"};
+    std::atomic<double> fps;
     int frameCount;
-    std::chrono::system_clock::time_point lastFPSUpdate;
+    std::chrono::steady_clock::time_point lastFPSUpdate;
 };
 
 class ErrorHandler {
@@ -181,7 +516,7 @@ private:
     std::function<void(const std::string&, bool)> errorCallback;
     std::string lastError;
     bool errorOccurred;
-    mutable std::mutex errorMutex;
+    mutable InstrumentedMutex errorMutex{"ErrorHandler"};
 };
 
 class ConfigManager {
@@ -201,7 +536,7 @@ private:
     ConfigManager& operator=(const ConfigManager&) = delete;
 
     std::unordered_map<std::string, std::string> config;
-    mutable std::mutex configMutex;
+    mutable InstrumentedMutex configMutex{"ConfigManager"};
 };
 
 // Convenience macros for logging
@@ -209,4 +544,419 @@ private:
 #define LOG_INFO(msg) Logger::getInstance().log(LogLevel::INFO, msg, __FILE__, __LINE__)
 #define LOG_WARNING(msg) Logger::getInstance().log(LogLevel::WARNING, msg, __FILE__, __LINE__)
 #define LOG_ERROR(msg) Logger::getInstance().log(LogLevel::ERROR, msg, __FILE__, __LINE__)
-#define LOG_FATAL(msg) Logger::getInstance().log(LogLevel::FATAL, msg, __FILE__, __LINE__) 
\ No newline at end of file
+#define LOG_FATAL(msg) Logger::getInstance().log(LogLevel::FATAL, msg, __FILE__, __LINE__)
+
+// Cache Implementation
+template<typename T>
+Cache<T>::Cache(size_t maxSize, CachePolicy policy, size_t shardCount)
+    : Cache(maxSize, 0, nullptr, policy, shardCount) {}
+
+template<typename T>
+Cache<T>::Cache(size_t maxSize, size_t maxBytes, CostFunction cost, CachePolicy policy, size_t shardCount)
+    : maxSize(maxSize), maxBytes(cost ? maxBytes : 0), byteBudget(this->maxBytes > 0 ? this->maxBytes : SIZE_MAX),
+      costFunction(std::move(cost)), policy(policy) {
+    if (shardCount == 0) {
+        shardCount = std::min(MAX_SHARDS, std::max<size_t>(1, maxSize / MIN_ENTRIES_PER_SHARD));
+    }
+    size_t perShard = std::max<size_t>(1, (maxSize + shardCount - 1) / shardCount);
+    shards.reserve(shardCount);
+    for (size_t i = 0; i < shardCount; ++i) {
+        shards.push_back(std::make_unique<Shard>());
+        shards.back()->capacity = perShard;
+    }
+}
+
+template<typename T>
+Cache<T>::~Cache() {
+    // Loader tasks hold a pointer to this cache; cancel them and wait them out
+    std::vector<std::shared_future<Handle>> pending;
+    for (auto& shard : shards) {
+        std::lock_guard<InstrumentedMutex> lock(shard->mutex);
+        for (auto& [key, load] : shard->loading) {
+            load->cancelled = true;
+            pending.push_back(load->future);
+        }
+    }
+    for (auto& future : pending) {
+        future.wait();
+    }
+}
+
+template<typename T>
+typename Cache<T>::Shard& Cache<T>::shardFor(std::string_view key) const {
+    size_t hash = std::hash<std::string_view>{}(key);
+    // Mix the high bits in so the shard choice doesn't track the bucket choice
+    hash ^= hash >> 29;
+    return *shards[hash % shards.size()];
+}
+
+template<typename T>
+typename Cache<T>::Handle Cache<T>::put(std::string_view key, T value) {
+    return put(key, std::make_shared<const T>(std::move(value)));
+}
+
+template<typename T>
+typename Cache<T>::Handle Cache<T>::put(std::string_view key, Handle value) {
+    // Measure before locking; cost functions may walk the whole value
+    size_t cost = costFunction && value ? costFunction(*value) : 0;
+
+    Shard& shard = shardFor(key);
+    {
+        std::lock_guard<InstrumentedMutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (cost > byteBudget) {
+            if (it != shard.index.end()) {
+                erase(shard, it);
+            }
+            shard.rejected++;
+            return value;
+        }
+        if (it != shard.index.end()) {
+            CacheEntry& entry = *it->second.entry;
+            shard.bytes = shard.bytes - entry.cost + cost;
+            totalBytes.fetch_add(cost - entry.cost, std::memory_order_relaxed);  // Wraps back when smaller
+            entry.value = value;
+            entry.cost = cost;
+            touch(shard, it->second);
+            // Make room among the shard's other entries, never the one just updated
+            while (totalBytes.load(std::memory_order_relaxed) > byteBudget &&
+                   &shard.buckets.front().entries.back() != &entry) {
+                evict(shard);
+            }
+        } else {
+            while (!shard.index.empty() &&
+                   (shard.index.size() >= shard.capacity ||
+                    totalBytes.load(std::memory_order_relaxed) + cost > byteBudget)) {
+                evict(shard);
+            }
+            insert(shard, key, value, cost);
+        }
+    }
+    if (totalBytes.load(std::memory_order_relaxed) > byteBudget) {
+        trimOtherShards(shard);
+    }
+    return value;
+}
+
+template<typename T>
+typename Cache<T>::Handle Cache<T>::get(std::string_view key) {
+    Shard& shard = shardFor(key);
+    std::lock_guard<InstrumentedMutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        shard.misses++;
+        return nullptr;
+    }
+    shard.hits++;
+    touch(shard, it->second);
+    return it->second.entry->value;
+}
+
+template<typename T>
+std::shared_future<typename Cache<T>::Handle> Cache<T>::getOrLoad(std::string_view key, Loader loader) {
+    return getOrLoad(key, std::move(loader), ThreadPool::getIOPool());
+}
+
+template<typename T>
+std::shared_future<typename Cache<T>::Handle> Cache<T>::getOrLoad(std::string_view key, Loader loader,
+                                                                  ThreadPool& pool) {
+    Shard& shard = shardFor(key);
+    auto promise = std::make_shared<std::promise<Handle>>();
+    auto load = std::make_shared<PendingLoad>();
+    {
+        std::lock_guard<InstrumentedMutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            shard.hits++;
+            touch(shard, it->second);
+            promise->set_value(it->second.entry->value);
+            return promise->get_future().share();
+        }
+        auto inFlight = shard.loading.find(key);
+        if (inFlight != shard.loading.end()) {
+            shard.coalesced++;
+            return inFlight->second->future;
+        }
+        shard.misses++;
+        load->key = std::string(key);
+        load->future = promise->get_future().share();
+        shard.loading.emplace(std::string_view(load->key), load);
+    }
+
+    try {
+        pool.enqueue([this, &shard, load, promise, loader = std::move(loader)] {
+            runLoad(shard, load, loader, *promise);
+        });
+    } catch (...) {
+        std::lock_guard<InstrumentedMutex> lock(shard.mutex);
+        shard.loading.erase(std::string_view(load->key));
+        throw;
+    }
+    return load->future;
+}
+
+template<typename T>
+void Cache<T>::runLoad(Shard& shard, const std::shared_ptr<PendingLoad>& load, const Loader& loader,
+                       std::promise<Handle>& promise) {
+    Handle value;
+    std::exception_ptr error;
+    if (!load->cancelled) {
+        try {
+            value = loader(load->cancelled);
+        } catch (...) {
+            error = std::current_exception();
+        }
+    }
+    if (load->cancelled) {
+        value = nullptr;
+    }
+    // Publish to the cache before leaving the in-flight table so a concurrent
+    // getOrLoad sees either the pending load or the cached value, never neither
+    if (value) {
+        put(load->key, value);
+    }
+    {
+        std::lock_guard<InstrumentedMutex> lock(shard.mutex);
+        shard.loading.erase(std::string_view(load->key));
+    }
+    if (error) {
+        promise.set_exception(error);
+    } else {
+        promise.set_value(value);
+    }
+}
+
+template<typename T>
+bool Cache<T>::cancelLoad(std::string_view key) {
+    Shard& shard = shardFor(key);
+    std::lock_guard<InstrumentedMutex> lock(shard.mutex);
+    auto it = shard.loading.find(key);
+    if (it == shard.loading.end()) {
+        return false;
+    }
+    it->second->cancelled = true;
+    return true;
+}
+
+template<typename T>
+bool Cache<T>::contains(std::string_view key) const {
+    Shard& shard = shardFor(key);
+    std::lock_guard<InstrumentedMutex> lock(shard.mutex);
+    return shard.index.find(key) != shard.index.end();
+}
+
+template<typename T>
+void Cache<T>::remove(std::string_view key) {
+    Shard& shard = shardFor(key);
+    std::lock_guard<InstrumentedMutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        erase(shard, it);
+    }
+}
+
+template<typename T>
+void Cache<T>::clear() {
+    for (auto& shard : shards) {
+        std::lock_guard<InstrumentedMutex> lock(shard->mutex);
+        shard->index.clear();
+        shard->buckets.clear();
+        totalBytes.fetch_sub(shard->bytes, std::memory_order_relaxed);
+        shard->bytes = 0;
+    }
+}
+
+template<typename T>
+size_t Cache<T>::size() const {
+    size_t total = 0;
+    for (const auto& shard : shards) {
+        std::lock_guard<InstrumentedMutex> lock(shard->mutex);
+        total += shard->index.size();
+    }
+    return total;
+}
+
+template<typename T>
+size_t Cache<T>::getHitCount() const {
+    size_t total = 0;
+    for (const auto& shard : shards) {
+        std::lock_guard<InstrumentedMutex> lock(shard->mutex);
+        total += shard->hits;
+    }
+    return total;
+}
+
+template<typename T>
+size_t Cache<T>::getMissCount() const {
+    size_t total = 0;
+    for (const auto& shard : shards) {
+        std::lock_guard<InstrumentedMutex> lock(shard->mutex);
+        total += shard->misses;
+    }
+    return total;
+}
+
+template<typename T>
+CacheStats Cache<T>::getStats() const {
+    CacheStats stats;
+    for (const auto& shard : shards) {
+        std::lock_guard<InstrumentedMutex> lock(shard->mutex);
+        stats.entries += shard->index.size();
+        stats.entryCapacity += shard->capacity;
+        stats.bytes += shard->bytes;
+        stats.hits += shard->hits;
+        stats.misses += shard->misses;
+        stats.evictions += shard->evictions;
+        stats.rejected += shard->rejected;
+        stats.coalesced += shard->coalesced;
+    }
+    stats.byteBudget = maxBytes;
+    return stats;
+}
+
+template<typename T>
+void Cache<T>::insert(Shard& shard, std::string_view key, Handle value, size_t cost) {
+    // New entries start in the lowest bucket: frequency 1 for LFU, the only bucket otherwise
+    size_t frequency = policy == CachePolicy::LFU ? 1 : 0;
+    auto bucket = shard.buckets.begin();
+    if (bucket == shard.buckets.end() || bucket->frequency != frequency) {
+        bucket = shard.buckets.insert(shard.buckets.begin(), Bucket{frequency, {}});
+    }
+    bucket->entries.push_front(CacheEntry{std::string(key), std::move(value), cost});
+    shard.bytes += cost;
+    totalBytes.fetch_add(cost, std::memory_order_relaxed);
+    auto entry = bucket->entries.begin();
+    shard.index.emplace(std::string_view(entry->key), Slot{bucket, entry});
+}
+
+template<typename T>
+void Cache<T>::touch(Shard& shard, Slot& slot) {
+    switch (policy) {
+        case CachePolicy::LRU: {
+            auto& entries = slot.bucket->entries;
+            entries.splice(entries.begin(), entries, slot.entry);
+            break;
+        }
+        case CachePolicy::LFU: {
+            auto current = slot.bucket;
+            auto next = std::next(current);
+            if (next == shard.buckets.end() || next->frequency != current->frequency + 1) {
+                next = shard.buckets.insert(next, Bucket{current->frequency + 1, {}});
+            }
+            next->entries.splice(next->entries.begin(), current->entries, slot.entry);
+            slot.bucket = next;
+            if (current->entries.empty()) {
+                shard.buckets.erase(current);
+            }
+            break;
+        }
+        case CachePolicy::FIFO:
+            break;
+    }
+}
+
+template<typename T>
+void Cache<T>::evict(Shard& shard) {
+    // The front bucket holds the lowest frequency; its back is the stalest entry
+    if (shard.buckets.empty()) {
+        return;
+    }
+    const CacheEntry& victim = shard.buckets.front().entries.back();
+    erase(shard, shard.index.find(std::string_view(victim.key)));
+    shard.evictions++;
+}
+
+template<typename T>
+void Cache<T>::trimOtherShards(const Shard& current) {
+    for (auto& other : shards) {
+        if (totalBytes.load(std::memory_order_relaxed) <= byteBudget) {
+            return;
+        }
+        if (other.get() == &current) {
+            continue;
+        }
+        std::lock_guard<InstrumentedMutex> lock(other->mutex);
+        while (!other->index.empty() && totalBytes.load(std::memory_order_relaxed) > byteBudget) {
+            evict(*other);
+        }
+    }
+}
+
+template<typename T>
+void Cache<T>::erase(Shard& shard, typename std::unordered_map<std::string_view, Slot>::iterator it) {
+    Slot slot = it->second;
+    shard.bytes -= slot.entry->cost;
+    totalBytes.fetch_sub(slot.entry->cost, std::memory_order_relaxed);
+    // Drop the index entry first; its key views the string owned by the list node
+    shard.index.erase(it);
+    slot.bucket->entries.erase(slot.entry);
+    if (slot.bucket->entries.empty()) {
+        shard.buckets.erase(slot.bucket);
+    }
+}
+
+// EventSystem Implementation
+template<typename Event>
+struct EventSystem::Queue : EventSystem::QueueBase {
+    std::vector<Event> pending;
+    std::vector<Event> dispatching;  // Swapped with pending so both keep their capacity
+
+    bool hasPending() const override { return !pending.empty(); }
+    void takePending() override { pending.swap(dispatching); }
+    void dispatch(const EventSystem& bus) override {
+        // Cleared on every exit: if a handler throws, the next takePending()
+        // must not swap these events back in to be delivered a second time
+        struct ClearOnExit {
+            std::vector<Event>& events;
+            ~ClearOnExit() { events.clear(); }
+        } clear{dispatching};
+        for (const Event& event : dispatching) {
+            bus.emit(event);
+        }
+    }
+};
+
+template<typename Event>
+uint32_t EventSystem::typeId() {
+    static const uint32_t id = nextTypeId();
+    return id;
+}
+
+template<typename Event>
+EventSystem::Subscription EventSystem::subscribe(std::function<void(const Event&)> handler) {
+    return addHandler(typeId<Event>(), [handler = std::move(handler)](const void* event) {
+        handler(*static_cast<const Event*>(event));
+    });
+}
+
+template<typename Event>
+void EventSystem::emit(const Event& event) const {
+    deliver(typeId<Event>(), &event);
+}
+
+template<typename Event>
+void EventSystem::post(Event event) {
+    uint32_t type = typeId<Event>();
+    std::lock_guard<InstrumentedMutex> lock(queueMutex);
+    std::unique_ptr<QueueBase>& queue = queues[type];
+    if (!queue) {
+        queue = std::make_unique<Queue<Event>>();
+    }
+    static_cast<Queue<Event>&>(*queue).pending.push_back(std::move(event));
+}
+
+// ThreadPool Implementation
+template<class F, class... Args>
+void ThreadPool::enqueue(F&& f, Args&&... args) {
+    auto task = std::make_shared<std::packaged_task<void()>>(
+        std::bind(std::forward<F>(f), std::forward<Args>(args)...)
+    );
+    {
+        std::unique_lock<InstrumentedMutex> lock(queueMutex);
+        if (stop) {
+            throw std::runtime_error("enqueue on stopped ThreadPool");
+        }
+        tasks.emplace([task]() { (*task)(); });
+    }
+    condition.notify_one();
+}
@@ -2,19 +2,40 @@
 
 #include <string>
 #include <memory>
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <thread>
+#include <vector>
 #include <nlohmann/json.hpp>
 #include "EngineBackend.h"
+#include "EngineSettings.h"
 
 using json = nlohmann::json;
 
+// Posted to EventSystem::getEngineEvents() by every successful load, so
+// handlers run on the main thread. Both snapshots stay valid for the
+// lifetime of the process
+struct ConfigChangedEvent {
+    const EngineSettings* previous;
+    const EngineSettings* current;
+};
+
 class EngineConfig {
 public:
     static EngineConfig& getInstance();
 
-    // Load and save configuration
+    // Load and save configuration. A successful load publishes a new settings
+    // snapshot and posts a ConfigChangedEvent; a failed one keeps the old snapshot
     bool loadConfig(const std::string& path = "engine_config.json");
     bool saveConfig(const std::string& path = "engine_config.json");
 
+    // Current snapshot: one atomic load, no lock. Hold on to the reference to
+    // read several settings consistently across a concurrent reload
+    const EngineSettings& getSettings() const {
+        return *current.load(std::memory_order_acquire);
+    }
+
     // Physics settings
     bool isGravityEnabled() const;
     double getGravityConstant() const;
@@ -37,6 +58,9 @@ public:
     float getCameraSpeed() const;
     float getSprintMultiplier() const;
     float getCameraSensitivity() const;
+    bool isLodEnabled() const;
+    float getLodMaxScreenError() const;
+    float getLodHysteresis() const;
 
     // Simulation settings
     int getMaxObjects() const;
@@ -54,18 +78,44 @@ public:
     size_t getMaxTextureMemory() const;
     size_t getMaxMeshMemory() const;
     size_t getMaxShaderMemory() const;
+    size_t getMemoryBudget(ResourceClass resourceClass) const;  // In bytes
+    CachePolicy getCachePolicyType() const;
+    std::string getDerivedCacheDirectory() const;
+    size_t getDerivedCacheMaxSize() const;  // In megabytes
+
+    // Cache sized from resource_management: entry limit from cache.max_size,
+    // byte budget from the memory.max_*_memory entry for the resource class
+    template<typename T>
+    std::unique_ptr<Cache<T>> createResourceCache(ResourceClass resourceClass,
+                                                  typename Cache<T>::CostFunction cost) const {
+        return std::make_unique<Cache<T>>(getCacheMaxSize(), getMemoryBudget(resourceClass),
+                                          std::move(cost), getCachePolicyType());
+    }
 
     // Debug settings
     std::string getLogLevel() const;
     std::string getLogFile() const;
     size_t getMaxLogFileSize() const;
     int getMaxLogFiles() const;
+    bool isConfigHotReloadEnabled() const;
+    double getConfigPollInterval() const;  // Seconds between checks of the config file
     bool isProfilingEnabled() const;
     double getProfilingInterval() const;
+    std::string getProfilingTraceFile() const;
+    std::vector<std::string> getProfilingMetrics() const;
+    double getHistogramWindow() const;  // Seconds covered by PerformanceMonitor percentiles
+    bool isHardwareCountersEnabled() const;
+    bool isSamplingProfilerEnabled() const;
+    int getSamplingRate() const;  // Hz of process CPU time
+    std::string getSamplingOutput() const;
+    bool isHotPathAllocationCheckEnabled() const;
+    int getAllocationWarmupFrames() const;
+    bool isAbortOnHotPathAllocation() const;
     bool isGridVisible() const;
     bool isTrajectoryVisible() const;
     bool isColliderVisible() const;
     bool isFPSVisible() const;
+    int getTextStressLabels() const;
 
     // Input settings
     std::string getKeyBinding(const std::string& action) const;
@@ -76,6 +126,9 @@ public:
     int getPhysicsThreads() const;
     int getRenderThreads() const;
     int getIOThreads() const;
+    size_t getFrameArenaSize() const;    // In megabytes, per buffer
+    size_t getScratchArenaSize() const;  // In megabytes, per thread
+    size_t getStreamingBufferSize() const;  // In megabytes, per StreamingBuffer ring
     bool isBatchingEnabled() const;
     int getMaxBatchSize() const;
     bool isCullingEnabled() const;
@@ -90,10 +143,22 @@ private:
 
     json config;
     std::string configPath;
-    mutable std::mutex configMutex;
+    std::filesystem::file_time_type configWriteTime;
+    mutable InstrumentedMutex configMutex{"EngineConfig"};
+
+    // Readers may still hold a replaced snapshot, so all of them are retained;
+    // a reload costs one EngineSettings
+    std::atomic<const EngineSettings*> current{nullptr};
+    std::vector<std::unique_ptr<const EngineSettings>> snapshots;
+
+    // Hot reload: polls the config file's modification time
+    std::thread watcher;
+    std::mutex watcherMutex;
+    std::condition_variable watcherCondition;
+    bool stopWatcher = false;
 
     // Helper methods
-    template<typename T>
-    T getValue(const std::string& path, const T& defaultValue) const;
-    bool validateConfig() const;
-}; 
\ No newline at end of file
+    bool validateConfig(const json& candidate) const;
+    const EngineSettings* publish(std::unique_ptr<const EngineSettings> settings);
+    void watchConfig();
+};
\ No newline at end of file
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+/*
+ * EngineSettings.h
+ *
+ * Typed, immutable snapshot of engine_config.json. EngineConfig compiles the
+ * JSON into one of these on every (re)load and publishes it through an
+ * atomic pointer, so reading a setting is a plain load: no lock, no string
+ * hashing, no JSON lookup.
+ *
+ * Members start at the engine defaults; fromJson() overrides each one whose
+ * key is present, addressed by JSON pointer (/physics/gravity/enabled). A
+ * value of the wrong type keeps the default and logs a warning.
+ */
+
+struct EngineSettings {
+    struct Physics {
+        bool gravityEnabled = true;
+        double gravityConstant = 6.67430e-11;
+        double maxGravityDistance = 1e12;
+        bool collisionEnabled = true;
+        int collisionIterations = 4;
+        double fixedTimestep = 0.016666;
+        double maxTimestep = 0.1;
+        double timeScale = 1.0;
+    };
+
+    struct Rendering {
+        int defaultWindowWidth = 1920;
+        int defaultWindowHeight = 1080;
+        bool vsync = true;
+        bool fullscreen = true;
+        bool resizable = true;
+        float fov = 45.0f;
+        float nearPlane = 0.1f;
+        float farPlane = 1000.0f;
+        float cameraSpeed = 2.5f;
+        float sprintMultiplier = 5.0f;
+        float cameraSensitivity = 0.1f;
+        bool lodEnabled = true;
+        float lodMaxScreenError = 0.5f;  // Pixels
+        float lodHysteresis = 0.25f;     // Fraction of the error budget
+    };
+
+    struct Simulation {
+        int maxObjects = 1000;
+        bool spatialPartitioning = true;
+        double gridSize = 100.0;
+        int maxObjectsPerCell = 50;
+        int trajectoryPredictionSteps = 100;
+        double trajectoryStepSize = 1.0;
+        double maxPredictionTime = 1000.0;
+    };
+
+    struct Resources {
+        size_t cacheMaxSize = 1024;
+        std::string cachePolicy = "LRU";
+        bool preloadAssets = true;
+        size_t maxTextureMemory = 1024;  // Megabytes
+        size_t maxMeshMemory = 512;
+        size_t maxShaderMemory = 64;
+        std::string derivedCacheDirectory = "derived_cache";
+        size_t derivedCacheMaxSize = 256;  // Megabytes
+    };
+
+    struct Debug {
+        std::string logLevel = "INFO";
+        std::string logFile = "engine.log";
+        size_t maxLogFileSize = 10;
+        int maxLogFiles = 5;
+        bool configHotReload = false;
+        double configPollInterval = 1.0;  // Seconds
+        bool profilingEnabled = true;
+        double profilingInterval = 0.1;
+        std::string profilingTraceFile;
+        std::vector<std::string> profilingMetrics = {"fps", "physics_time", "render_time", "render_submit",
+                                                     "draw_calls", "triangles", "vertices", "visible_objects",
+                                                     "culled_objects", "occluded_objects", "memory_usage",
+                                                     "allocations", "frame_arena"};
+        double histogramWindow = 10.0;
+        bool hardwareCounters = false;
+        bool samplingEnabled = false;
+        int samplingRate = 99;
+        std::string samplingOutput = "profile.folded";
+        bool checkHotPathAllocations = false;
+        int allocationWarmupFrames = 300;
+        bool abortOnHotPathAllocation = false;
+        bool showGrid = true;
+        bool showTrajectories = true;
+        bool showColliders = false;
+        bool showFPS = true;
+        int textStressLabels = 0;  // HUD labels drawn each frame to stress text rendering
+    };
+
+    struct Input {
+        // Action -> key; movement bindings take precedence over camera ones
+        std::unordered_map<std::string, std::string> keyBindings;
+        float mouseSensitivity = 0.1f;
+        bool invertMouseY = false;
+    };
+
+    struct Optimization {
+        int physicsThreads = 4;
+        int renderThreads = 1;
+        int ioThreads = 2;
+        size_t frameArenaSize = 4;    // Megabytes
+        size_t scratchArenaSize = 1;  // Megabytes
+        size_t streamingBufferSize = 4;  // Megabytes
+        bool batchingEnabled = true;
+        int maxBatchSize = 1000;
+        bool cullingEnabled = true;
+        bool frustumCulling = true;
+        bool occlusionCulling = true;
+    };
+
+    Physics physics;
+    Rendering rendering;
+    Simulation simulation;
+    Resources resources;
+    Debug debug;
+    Input input;
+    Optimization optimization;
+
+    static EngineSettings fromJson(const nlohmann::json& source);
+};
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+ * FrameArena.h
+ *
+ * Bump allocators for data that lives no longer than a frame. They plug into
+ * std::pmr containers, so transient vectors and strings never reach the
+ * general heap:
+ *
+ *   FrameArena - two arenas used in turn. Memory allocated in frame N stays
+ *                valid until the end of frame N+1, so one thread can hand a
+ *                frame's data (render commands, pair lists) to another.
+ *                Any thread may allocate. PerformanceMonitor::endFrame()
+ *                swaps the arenas.
+ *   Scratch    - one arena per thread, used like a stack: a ScratchScope
+ *                rewinds everything allocated inside it when it closes.
+ *
+ *   ScratchScope scratch;
+ *   std::pmr::vector<Vector> accelerations(n, scratch.resource());
+ *
+ * When an arena is full, it takes memory from the heap and counts an
+ * overflow; that memory is released when the arena is reset. Sizes come from
+ * optimization.memory.frame_arena_size and scratch_arena_size.
+ */
+
+class LinearArena : public std::pmr::memory_resource {
+public:
+    struct Marker {
+        size_t offset;
+        size_t overflowBlocks;
+    };
+
+    explicit LinearArena(size_t capacity);
+    ~LinearArena() override;
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    void reset();  // Not safe while other threads allocate
+    Marker mark() const;
+    void rewind(const Marker& marker);  // Frees everything allocated since mark()
+
+    size_t getUsed() const;       // Bytes handed out since the last reset, overflow included
+    size_t getCapacity() const { return capacity; }
+    size_t getHighWater() const;  // Most bytes in use at once since construction
+    uint64_t getOverflowCount() const { return overflowCount.load(std::memory_order_relaxed); }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}  // Reclaimed by reset() or rewind()
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    void updateHighWater();
+
+    std::unique_ptr<std::byte[]> buffer;
+    size_t capacity;
+    std::atomic<size_t> offset;
+    std::atomic<size_t> overflowBytes;
+    std::atomic<size_t> highWater;
+    std::atomic<uint64_t> overflowCount;
+    std::vector<std::pair<void*, size_t>> overflowBlocks;
+    mutable std::mutex overflowMutex;
+};
+
+class FrameArena {
+public:
+    static FrameArena& getInstance();
+
+    // Valid until the end of the frame after this one
+    std::pmr::memory_resource* resource() { return &arenas[currentIndex.load(std::memory_order_acquire)]; }
+    void endFrame();  // Resets the arena from two frames ago and makes it current
+
+    // The calling thread's scratch arena; prefer ScratchScope
+    static LinearArena& scratch();
+
+    size_t getLastFrameUsage() const { return lastFrameUsage.load(std::memory_order_relaxed); }
+    size_t getFrameHighWater() const;
+    size_t getScratchHighWater() const { return scratchHighWater.load(std::memory_order_relaxed); }
+    uint64_t getOverflowCount() const;
+    std::string getReport() const;
+
+    void noteScratchUsage(size_t bytes);
+
+private:
+    FrameArena();
+    ~FrameArena();
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    size_t scratchCapacity;
+    LinearArena arenas[2];
+    std::atomic<size_t> currentIndex;
+    std::atomic<size_t> lastFrameUsage;
+    std::atomic<size_t> scratchHighWater;
+};
+
+class ScratchScope {
+public:
+    ScratchScope();
+    ~ScratchScope();
+
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+    std::pmr::memory_resource* resource() const { return &arena; }
+
+private:
+    LinearArena& arena;
+    LinearArena::Marker marker;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "glm/glm.hpp"
+
+class ThreadPool;
+
+/*
+ * Frustum.h
+ *
+ * View-frustum planes and bulk sphere tests for culling. Planes are pulled
+ * straight out of the combined projection * view matrix (Gribb/Hartmann) and
+ * normalized, so a plane's distance to a sphere center compares directly
+ * against the radius.
+ *
+ * Spheres are tested in structure-of-arrays form, four at a time with SSE
+ * where available, and cullSpheresParallel() splits large sets across a
+ * thread pool:
+ *   SphereArrays spheres;  // Filled from the bodies
+ *   Frustum frustum = Frustum::fromViewProjection(projection * view);
+ *   size_t visible = frustum.cullSpheresParallel(spheres, flags.data(), ThreadPool::getRenderPool());
+ */
+
+// One array per component, so four spheres load as one SIMD register each
+struct SphereArrays {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<float> radius;
+
+    void resize(size_t count);
+    size_t size() const { return x.size(); }
+};
+
+class Frustum {
+public:
+    // Below this many spheres a parallel cull runs on the calling thread only
+    static constexpr size_t PARALLEL_THRESHOLD = 4096;
+
+    static Frustum fromViewProjection(const glm::mat4& viewProjection);
+
+    bool intersectsSphere(const glm::vec3& center, float radius) const;
+    // Sets visible[i] to 1 or 0 for each sphere in [first, last); returns how many are visible
+    size_t cullSpheres(const SphereArrays& spheres, size_t first, size_t last, uint8_t* visible) const;
+    // Same over the whole set; the calling thread takes one share and waits for the rest
+    size_t cullSpheresParallel(const SphereArrays& spheres, uint8_t* visible, ThreadPool& pool) const;
+
+private:
+    std::array<glm::vec4, 6> planes;  // xyz inward normal, w distance; left, right, bottom, top, near, far
+};
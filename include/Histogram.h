@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+
+/*
+ * Histogram.h
+ *
+ * Log-linear (HDR-style) histogram of non-negative integer samples. Every
+ * power of two is split into 16 linear sub-buckets, so a reported percentile
+ * is within about 6% of the true value anywhere in the range, at a fixed
+ * 2.8 KB per slot.
+ *
+ * record() is a single relaxed atomic add and never locks. The rolling window
+ * is a ring of slots: advance() retires the oldest slot and starts a new one,
+ * and summarize() merges the live slots, so it may run while other threads
+ * keep recording.
+ */
+
+class Histogram {
+public:
+    struct Summary {
+        uint64_t count = 0;
+        uint64_t p50 = 0;
+        uint64_t p90 = 0;
+        uint64_t p99 = 0;
+        uint64_t max = 0;
+    };
+
+    explicit Histogram(size_t windowSlots = 1);
+
+    void record(uint64_t value);
+    void advance();
+    void reset();
+
+    Summary summarize() const;
+    uint64_t percentile(double fraction) const;  // fraction in [0, 1]
+
+    size_t getWindowSlots() const { return slotCount; }
+
+    static size_t bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(size_t index);
+
+private:
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr size_t SUB_BUCKETS = size_t(1) << SUB_BUCKET_BITS;
+    static constexpr int MAX_EXPONENT = 48;  // Larger values share the top bucket
+    static constexpr size_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    struct Slot {
+        std::atomic<uint32_t> counts[BUCKET_COUNT];
+        std::atomic<uint64_t> max;
+    };
+
+    void clearSlot(Slot& slot);
+    // Merged counts of the live slots; returns the total and fills max
+    uint64_t merge(uint64_t* counts, uint64_t& max) const;
+    static uint64_t valueAt(const uint64_t* counts, uint64_t total, uint64_t max, double fraction);
+
+    std::unique_ptr<Slot[]> slots;
+    size_t slotCount;
+    std::atomic<size_t> current;
+};
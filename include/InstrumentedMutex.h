@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Histogram.h"
+
+struct ProfileZone;
+
+/*
+ * InstrumentedMutex.h
+ *
+ * Drop-in std::mutex replacement that measures contention. Every acquisition
+ * is counted; one that finds the mutex held also records its wait time in a
+ * histogram, attributes it to the calling code, and emits a "lock" event to
+ * the Profiler so the waits appear on the trace timeline.
+ *
+ * Mutexes with the same name share statistics, e.g. every cache shard:
+ *   mutable InstrumentedMutex mutex{"Cache::Shard"};
+ *   std::lock_guard<InstrumentedMutex> lock(mutex);
+ *
+ * Call sites are the return addresses of lock(), symbolized in the report,
+ * so they name the function that took the lock in optimized builds. Use
+ * std::condition_variable_any to wait on one. The uncontended path costs a
+ * try_lock and one relaxed atomic add over std::mutex.
+ */
+
+struct LockStats {
+    struct Site {
+        uint64_t contentions = 0;
+        uint64_t waitNanos = 0;
+    };
+
+    explicit LockStats(const std::string& name) : name(name) {}
+
+    std::string name;
+    std::atomic<const ProfileZone*> zone{nullptr};  // Interned on first contention
+    std::atomic<uint64_t> acquisitions{0};
+    std::atomic<uint64_t> contentions{0};
+    std::atomic<uint64_t> waitNanos{0};
+    Histogram waitTimes;  // Nanoseconds, contended acquisitions only
+
+    mutable std::mutex sitesMutex;
+    std::unordered_map<uintptr_t, Site> sites;  // Keyed by return address of lock()
+};
+
+class InstrumentedMutex {
+public:
+    explicit InstrumentedMutex(const char* name);
+
+    InstrumentedMutex(const InstrumentedMutex&) = delete;
+    InstrumentedMutex& operator=(const InstrumentedMutex&) = delete;
+
+    void lock();
+    bool try_lock();
+    void unlock() { mutex.unlock(); }
+
+    const std::string& getName() const { return stats->name; }
+
+private:
+    void lockContended(uintptr_t site);
+
+    std::mutex mutex;
+    LockStats* stats;
+};
+
+class LockRegistry {
+public:
+    struct Summary {
+        std::string name;
+        uint64_t acquisitions = 0;
+        uint64_t contentions = 0;
+        double totalWaitMs = 0.0;
+        double p50WaitUs = 0.0;
+        double p99WaitUs = 0.0;
+        double maxWaitUs = 0.0;
+        std::vector<std::pair<uintptr_t, LockStats::Site>> sites;  // Most total wait first
+    };
+
+    static LockRegistry& getInstance();
+
+    LockStats* statsFor(const std::string& name);
+
+    std::vector<Summary> getSummaries() const;  // Most total wait time first
+    // Locks by total wait time, each with its worst call sites
+    std::string getReport(size_t maxLocks = 10, size_t maxSites = 3) const;
+    void reset();
+
+private:
+    LockRegistry();
+    ~LockRegistry();
+    LockRegistry(const LockRegistry&) = delete;
+    LockRegistry& operator=(const LockRegistry&) = delete;
+
+    // Stats are never erased, so mutexes may keep pointers to them
+    std::list<LockStats> locks;
+    mutable std::mutex registryMutex;
+};
@@ -1,7 +1,12 @@
 #pragma once
 #include "Vector.h"
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <utility>
+
+struct MeshView;
 
 struct Vertex {
     Vector position;
@@ -20,6 +25,10 @@ public:
     // Mesh data
     void addVertex(const Vertex& vertex) { vertices.push_back(vertex); }
     void addTriangle(const Triangle& triangle) { triangles.push_back(triangle); }
+    void setGeometry(std::vector<Vertex> newVertices, std::vector<Triangle> newTriangles) {
+        vertices = std::move(newVertices);
+        triangles = std::move(newTriangles);
+    }
     
     // Mesh properties
     void setName(const std::string& newName) { name = newName; }
@@ -30,6 +39,10 @@ public:
     const std::vector<Triangle>& getTriangles() const { return triangles; }
     const std::string& getName() const { return name; }
     const Vector& getColor() const { return color; }
+    size_t getMemoryUsage() const {
+        return sizeof(Mesh) + vertices.capacity() * sizeof(Vertex) +
+               triangles.capacity() * sizeof(Triangle) + name.capacity();
+    }
     
     // Mesh operations
     void clear() {
@@ -39,6 +52,17 @@ public:
     
     // Create a simple sphere mesh
     static Mesh createSphere(double radius, int segments);
+
+    // Bump when createSphere output changes; keys the cached sphere LODs
+    static constexpr uint32_t SPHERE_GENERATOR_VERSION = 1;
+
+    // Flat binary form, read by mesh-converter's "mesh" inputs
+    std::vector<char> serialize() const;
+    static bool deserialize(std::string_view bytes, Mesh& mesh);
+
+    // Decodes cooked data (a MeshFile LOD or a CookedMesh) back into an
+    // editable mesh; triangles with an out-of-range index are dropped
+    static Mesh fromView(const MeshView& view);
     
     // Create a simple cube mesh
     static Mesh createCube(double size);
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "glm/glm.hpp"
+#include "Mesh.h"
+
+/*
+ * MeshCooker.h
+ *
+ * Turns an editable Mesh (double-precision Vertex, 72 bytes each) into the
+ * compact layout the GPU draws from:
+ *   - positions as snorm16 inside the mesh bounds, decoded with
+ *     positionOffset + value * positionScale
+ *   - normals octahedral-encoded into two snorm16
+ *   - texture coordinates as half floats
+ *   - duplicate vertices merged and degenerate triangles dropped after
+ *     quantization
+ *   - 16-bit indices when every vertex fits
+ *   - triangles reordered for the post-transform vertex cache (Forsyth), then
+ *     cache-friendly clusters sorted outside-in to cut overdraw
+ *
+ * Vertex shader decode for the normal:
+ *   vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+ *   float t = max(-n.z, 0.0);
+ *   n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+ */
+
+struct PackedVertex {
+    int16_t position[4];   // xyz snorm16; w unused, keeps the normal 8-byte aligned
+    int16_t normal[2];     // Octahedral snorm16
+    uint16_t texCoord[2];  // Half floats
+};
+static_assert(sizeof(PackedVertex) == 16, "PackedVertex layout is uploaded as is");
+
+// Non-owning view of cooked mesh data, from a CookedMesh or a mapped MeshFile
+struct MeshView {
+    const PackedVertex* vertices = nullptr;
+    size_t vertexCount = 0;
+    const void* indices = nullptr;
+    size_t indexCount = 0;
+    size_t indexSize = 0;  // 2 or 4 bytes
+    glm::vec3 positionOffset = glm::vec3(0.0f);
+    glm::vec3 positionScale = glm::vec3(1.0f);
+
+    uint32_t index(size_t i) const {
+        return indexSize == sizeof(uint16_t) ? static_cast<const uint16_t*>(indices)[i]
+                                             : static_cast<const uint32_t*>(indices)[i];
+    }
+};
+
+struct CookedMesh {
+    struct Stats {
+        size_t sourceVertices = 0;
+        size_t sourceTriangles = 0;
+        size_t sourceBytes = 0;  // As uploaded before cooking: float32 attributes, 32-bit indices
+        size_t cookedBytes = 0;
+        float acmrBefore = 0.0f;  // Average cache misses per triangle, FIFO of ACMR_CACHE_SIZE
+        float acmrAfter = 0.0f;
+    };
+
+    std::vector<PackedVertex> vertices;
+    std::vector<uint16_t> indices16;  // Exactly one of the two is filled
+    std::vector<uint32_t> indices32;
+    glm::vec3 positionOffset = glm::vec3(0.0f);
+    glm::vec3 positionScale = glm::vec3(1.0f);
+    Stats stats;
+
+    size_t indexCount() const { return indices16.empty() ? indices32.size() : indices16.size(); }
+    size_t indexSize() const { return indices16.empty() ? sizeof(uint32_t) : sizeof(uint16_t); }
+    const void* indexData() const {
+        return indices16.empty() ? static_cast<const void*>(indices32.data()) : indices16.data();
+    }
+    MeshView view() const {
+        return MeshView{vertices.data(), vertices.size(), indexData(), indexCount(), indexSize(),
+                        positionOffset, positionScale};
+    }
+};
+
+class MeshCooker {
+public:
+    static constexpr size_t ACMR_CACHE_SIZE = 16;
+    static constexpr uint32_t VERSION = 1;  // Bump when cooked output changes
+
+    static CookedMesh cook(const Mesh& mesh);
+    // "V -> V' vertices, T -> T' triangles, B -> B' bytes, ACMR a -> a'"
+    static std::string describe(const CookedMesh& mesh);
+
+    // Post-transform cache misses per triangle for a FIFO cache of cacheSize entries
+    static float computeACMR(const std::vector<uint32_t>& indices, size_t vertexCount,
+                             size_t cacheSize = ACMR_CACHE_SIZE);
+    // Forsyth's linear-speed vertex cache ordering, in place
+    static void optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+    // Sorts cache-flush-delimited clusters so outward-facing ones draw first;
+    // keeps the input order when that would cost more than 5% ACMR
+    static void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions);
+
+    static void encodeOctahedral(const glm::vec3& normal, int16_t out[2]);
+    static glm::vec3 decodeOctahedral(const int16_t in[2]);
+};
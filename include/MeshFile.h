@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "glm/glm.hpp"
+#include "EngineBackend.h"
+#include "MeshCooker.h"
+
+/*
+ * MeshFile.h
+ *
+ * Binary container for cooked meshes, laid out so a memory-mapped file can
+ * be handed to glBufferData as is: no parsing, no per-vertex conversion.
+ *
+ * Layout (little-endian, offsets from the start of the file):
+ *   FileHeader                   bounds of the finest LOD
+ *   LodEntry[lodCount]           finest first
+ *   vertex and index blobs       PackedVertex / uint16 or uint32, each aligned
+ *                                to DATA_ALIGNMENT
+ *
+ * Each LOD records its geometric error, the largest distance between its
+ * surface and the finest one, so a renderer can pick LODs by screen error.
+ *
+ * Opening checks every offset, that each LOD holds whole triangles and that
+ * every index names one of its vertices, so views of an open file are safe
+ * to draw or walk even when the file came from outside.
+ *
+ *   MeshFile file;
+ *   if (file.open("meshes/asteroid.mesh")) {
+ *       MeshView lod = file.getLod(0);  // Points into the mapping
+ *   }
+ */
+
+class MeshFile {
+public:
+    static constexpr uint32_t MAGIC = 0x48534D41;  // "AMSH"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t DATA_ALIGNMENT = 16;
+    static constexpr uint32_t VERTEX_FORMAT_PACKED16 = 1;  // PackedVertex
+
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t lodCount;
+        uint32_t vertexFormat;
+        float boundsMin[3];
+        float boundsMax[3];
+        float boundsRadius;  // Around the origin
+        uint32_t reserved;
+        uint64_t lodTableOffset;
+    };
+
+    struct LodEntry {
+        uint64_t vertexOffset;
+        uint64_t indexOffset;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint32_t indexSize;
+        float geometricError;
+        float positionOffset[3];
+        float positionScale[3];
+    };
+
+    struct LodSource {
+        const CookedMesh* mesh;
+        float geometricError;
+    };
+
+    MeshFile() = default;
+    MeshFile(const MeshFile&) = delete;
+    MeshFile& operator=(const MeshFile&) = delete;
+
+    bool open(const std::string& path);
+    // Takes over a mapping whose bytes (e.g. a DerivedAssetCache payload) hold a mesh file
+    bool open(MappedFile&& mapping, std::string_view bytes);
+    // Loads the cached file for key, or builds it with build(), caches it and keeps it in memory
+    bool openCached(const std::string& key, const std::function<std::vector<uint8_t>()>& build);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+
+    size_t getLodCount() const { return header ? header->lodCount : 0; }
+    MeshView getLod(size_t lod) const;
+    float getGeometricError(size_t lod) const { return lods[lod].geometricError; }
+    glm::vec3 getBoundsMin() const;
+    glm::vec3 getBoundsMax() const;
+    float getBoundsRadius() const { return header ? header->boundsRadius : 0.0f; }
+
+    // LODs finest first; bounds are taken from the first
+    static std::vector<uint8_t> serialize(const std::vector<LodSource>& lods);
+    static bool write(const std::string& path, const std::vector<LodSource>& lods);
+
+private:
+    bool parse(std::string_view bytes, const std::string& source);
+
+    MappedFile file;
+    std::vector<uint8_t> owned;  // Built by openCached when the cache could not be mapped back
+    const FileHeader* header = nullptr;
+    const LodEntry* lods = nullptr;
+    const uint8_t* base = nullptr;
+};
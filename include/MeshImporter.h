@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Mesh.h"
+#include "MeshCooker.h"
+
+class ThreadPool;
+
+/*
+ * MeshImporter.h
+ *
+ * Imports Wavefront OBJ and glTF 2.0 (.gltf with external or embedded
+ * buffers, .glb) models into Meshes, or straight into cooked meshes.
+ *
+ * OBJ files are memory-mapped and split at line boundaries into one chunk per
+ * worker. A first parallel pass counts the v/vt/vn lines of every chunk so
+ * each chunk knows where its attributes land in the shared arrays; a second
+ * pass parses the chunks in parallel (std::from_chars, no iostreams) straight
+ * into those arrays, resolving relative indices as it goes. Polygons are
+ * fanned into triangles and v/vt/vn corners merged into unique vertices.
+ * Missing normals are computed from the faces. Groups and materials are
+ * ignored: one OBJ file becomes one Mesh.
+ *
+ * glTF files produce one Mesh per glTF mesh, primitives concatenated, in
+ * mesh space (node transforms are not applied). Only triangle lists are read.
+ *
+ *   std::vector<Mesh> meshes;
+ *   MeshImporter::ImportStats stats;
+ *   if (MeshImporter::importFile("models/eros.obj", meshes, &stats)) {
+ *       world.addMesh("eros", meshes[0]);  // stats.throughputMBps()
+ *   }
+ *
+ * Do not call from a task running on the pool passed in: the import waits on
+ * that pool's workers.
+ */
+
+class MeshImporter {
+public:
+    static constexpr size_t MIN_CHUNK_BYTES = 1 << 20;  // Smaller files parse on one thread
+
+    struct ImportStats {
+        size_t bytes = 0;  // Source size, including external glTF buffers
+        size_t vertices = 0;
+        size_t triangles = 0;
+        size_t droppedTriangles = 0;  // Referenced missing vertices
+        double parseMs = 0.0;         // Mapping and parsing
+        double buildMs = 0.0;         // Vertex merging and Mesh construction
+
+        double throughputMBps() const {
+            double seconds = (parseMs + buildMs) / 1000.0;
+            return seconds > 0.0 ? bytes / (1024.0 * 1024.0) / seconds : 0.0;
+        }
+    };
+
+    // Picks the format from the extension (.obj, .gltf, .glb); uses the IO pool
+    static bool importFile(const std::string& path, std::vector<Mesh>& meshes, ImportStats* stats = nullptr);
+    static bool importFile(const std::string& path, std::vector<Mesh>& meshes, ThreadPool& pool,
+                           ImportStats* stats = nullptr);
+    // Imports, then cooks the meshes in parallel, freeing each Mesh once cooked
+    static bool importCooked(const std::string& path, std::vector<CookedMesh>& cooked, ThreadPool& pool,
+                             ImportStats* stats = nullptr);
+
+    static bool importObj(std::string_view text, const std::string& name, Mesh& mesh, ThreadPool& pool,
+                          ImportStats* stats = nullptr);
+    static bool importGltf(const std::string& path, std::vector<Mesh>& meshes, ThreadPool& pool,
+                           ImportStats* stats = nullptr);
+};
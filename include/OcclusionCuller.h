@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "glm/glm.hpp"
+#include "Frustum.h"
+
+class ThreadPool;
+
+/*
+ * OcclusionCuller.h
+ *
+ * Software occlusion culling against a hierarchical depth (Hi-Z) buffer.
+ * Each frame build() picks the spheres that cover the most screen, rasterizes
+ * them into a small linear-depth buffer and reduces it into a max-depth
+ * pyramid; cull() then rejects spheres whose nearest point lies behind the
+ * farthest occluder depth over their screen bounds.
+ *
+ * Occluders are drawn as the inner 70% of their projected disc at the depth
+ * of their center. Every ray through that disc enters the sphere in front of
+ * the center's depth for fields of view up to about 90 degrees, so the buffer
+ * never claims more occlusion than there is.
+ *
+ *   culler.build(view, projection, spheres, visible, pool);
+ *   size_t rejected = culler.cullParallel(spheres, visible, pool);
+ */
+
+class OcclusionCuller {
+public:
+    static constexpr int WIDTH = 256;   // Powers of two, so every level halves evenly
+    static constexpr int HEIGHT = 128;
+    static constexpr size_t MAX_OCCLUDERS = 32;
+    static constexpr float MIN_OCCLUDER_PIXELS = 4.0f;  // Projected radius in depth buffer pixels
+
+    OcclusionCuller();
+
+    // Rasterizes the largest spheres with visible[i] set and rebuilds the pyramid
+    void build(const glm::mat4& view, const glm::mat4& projection, const SphereArrays& spheres,
+               const uint8_t* visible, ThreadPool& pool);
+    // Clears visible[i] for occluded spheres in [first, last); returns how many it cleared
+    size_t cull(const SphereArrays& spheres, size_t first, size_t last, uint8_t* visible) const;
+    size_t cullParallel(const SphereArrays& spheres, uint8_t* visible, ThreadPool& pool) const;
+
+    size_t getOccluderCount() const { return occluders.size(); }
+
+private:
+    struct ViewSphere {
+        glm::vec3 center;  // View space, z is distance in front of the camera
+        float radius;
+    };
+    struct Occluder {
+        float x, y;    // Depth buffer pixels
+        float rx, ry;  // Inner disc radii in pixels
+        float depth;
+    };
+    struct Level {
+        int width;
+        int height;
+        std::vector<float> depth;  // Row-major, farthest depth of the texels below
+    };
+
+    ViewSphere toView(const SphereArrays& spheres, size_t i) const;
+    bool isOccluded(const ViewSphere& sphere) const;
+    void rasterize(int firstRow, int lastRow);
+    void buildLevel(size_t level);
+
+    glm::mat4 viewMatrix;
+    float scaleX, scaleY;  // View-space x/z and y/z to depth buffer pixels
+    std::vector<Occluder> occluders;
+    std::vector<std::pair<float, size_t>> candidates;  // Projected radius, sphere index
+    std::vector<Level> levels;  // levels[0] is WIDTH x HEIGHT
+};
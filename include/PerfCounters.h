@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include "Profiler.h"
+
+/*
+ * PerfCounters.h
+ *
+ * Hardware performance counters (cycles, instructions, L1D and LLC read
+ * misses, branch misses) read through perf_event_open on Linux. Counters are
+ * opened lazily per thread as one event group, so a read is one syscall and
+ * all values cover the same interval.
+ *
+ * Opt-in via debug.profiling.hardware_counters. When the kernel refuses
+ * (perf_event_paranoid, containers, VMs without a PMU) or on other
+ * platforms, reads report no counters and scopes cost one branch. Counters
+ * the CPU lacks are left out individually.
+ *
+ * A read costs a syscall, so attribute counters to coarse scopes only:
+ *   void Simulator::calculateForces() {
+ *       PROFILE_SCOPE_COUNTERS("Simulator::calculateForces", "physics");
+ *       ...
+ *   }
+ */
+
+enum class PerfCounter {
+    Cycles,
+    Instructions,
+    L1DMisses,
+    LLCMisses,
+    BranchMisses,
+    Count
+};
+
+struct PerfSample {
+    static constexpr size_t COUNTER_COUNT = static_cast<size_t>(PerfCounter::Count);
+
+    uint64_t values[COUNTER_COUNT] = {};
+    uint32_t availableMask = 0;  // Bit per PerfCounter that was actually measured
+
+    bool has(PerfCounter counter) const { return availableMask & (1u << static_cast<unsigned>(counter)); }
+    uint64_t get(PerfCounter counter) const { return values[static_cast<size_t>(counter)]; }
+    double getIPC() const;  // Instructions per cycle, 0 if either is missing
+
+    PerfSample operator-(const PerfSample& earlier) const;
+    PerfSample& operator+=(const PerfSample& other);
+};
+
+class PerfCounters {
+public:
+    struct ZoneTotals {
+        const ProfileZone* zone = nullptr;
+        uint64_t calls = 0;
+        PerfSample totals;
+    };
+
+    static PerfCounters& getInstance();
+
+    void setEnabled(bool value) { enabled.store(value, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Current counter values for the calling thread; false if none are available
+    bool read(PerfSample& sample);
+
+    void accumulate(const ProfileZone* zone, const PerfSample& delta);
+    std::vector<ZoneTotals> getZoneTotals() const;
+    void resetZoneTotals();
+    std::string getReport() const;  // Per zone: calls, IPC and counts per call
+
+    static const char* getCounterName(PerfCounter counter);
+
+private:
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    struct ThreadCounters;
+    ThreadCounters& localCounters();
+
+    std::atomic<bool> enabled;
+    std::atomic<bool> unavailableLogged;
+    std::unordered_map<const ProfileZone*, ZoneTotals> zoneTotals;
+    mutable std::mutex countersMutex;
+};
+
+// Measures counter deltas over its lifetime; with a zone, they are added to
+// that zone's totals
+class PerfCounterScope {
+public:
+    explicit PerfCounterScope(const ProfileZone* zone = nullptr);
+    ~PerfCounterScope();
+
+    PerfCounterScope(const PerfCounterScope&) = delete;
+    PerfCounterScope& operator=(const PerfCounterScope&) = delete;
+
+    // Ends the measurement early and returns the delta (empty if unavailable)
+    const PerfSample& stop();
+
+private:
+    const ProfileZone* zone;
+    PerfSample start;
+    PerfSample delta;
+    bool active = false;
+};
+
+#define PROFILE_SCOPE_COUNTERS(name, category) \
+    static constexpr ProfileZone PROFILE_CONCAT(profileZone_, __LINE__){name, category, __FILE__, __LINE__}; \
+    ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(PROFILE_CONCAT(profileZone_, __LINE__)); \
+    PerfCounterScope PROFILE_CONCAT(counterScope_, __LINE__)(&PROFILE_CONCAT(profileZone_, __LINE__))
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+/*
+ * Profiler.h
+ *
+ * Hierarchical scope profiler. PROFILE_SCOPE("name") times the enclosing
+ * block; nested scopes record their depth, so a trace shows the call tree.
+ *
+ * Each call site owns a static ProfileZone, so a zone is identified by its
+ * address and recording an event never hashes or copies the name. Events go
+ * into a per-thread single-producer ring without locking; collect() moves
+ * them into the profiler's history, and exportChromeTrace() writes that
+ * history in the Chrome trace event format (chrome://tracing, ui.perfetto.dev).
+ *
+ * Usage:
+ *   void Simulator::step(double dt) {
+ *       PROFILE_SCOPE_CATEGORY("Simulator::step", "physics");
+ *       ...
+ *   }
+ */
+
+// Static description of a profiled scope; one per PROFILE_SCOPE site
+struct ProfileZone {
+    const char* name;
+    const char* category;
+    const char* file;
+    int line;
+};
+
+struct ProfileEvent {
+    const ProfileZone* zone;
+    uint64_t start;     // Nanoseconds since the profiler epoch
+    uint64_t end;
+    uint32_t depth;     // Nesting level within the thread, 0 = outermost
+    uint32_t thread;    // Profiler thread index
+};
+
+class Profiler {
+public:
+    static Profiler& getInstance();
+    // nullptr until getInstance() has finished constructing the profiler; for
+    // callers that may run during that construction, such as lock instrumentation
+    static Profiler* peekInstance() { return constructed.load(std::memory_order_acquire); }
+
+    void setEnabled(bool value) { enabled.store(value, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Monotonic nanoseconds since the profiler was created
+    static uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - epoch()).count());
+    }
+
+    // Called by ProfileScope; lock-free unless this is the thread's first event
+    void record(const ProfileZone* zone, uint64_t start, uint64_t end, uint32_t depth);
+
+    // Zone for a name only known at run time; the zone lives as long as the profiler
+    const ProfileZone* internZone(const std::string& name, const char* category = "engine");
+
+    // Label for the calling thread in exported traces
+    void setThreadName(const std::string& name);
+
+    // Moves events from the per-thread rings into the history. Call once per
+    // frame or so; rings that fill up between calls drop their newest events.
+    void collect();
+
+    std::vector<ProfileEvent> getEvents();
+    bool exportChromeTrace(const std::string& path);
+    void clear();
+
+    size_t getDroppedEventCount() const;
+
+private:
+    Profiler();
+    ~Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    static constexpr size_t RING_CAPACITY = 1 << 14;       // Events per thread between collects
+    static constexpr size_t MAX_HISTORY = 1 << 20;         // Oldest events are discarded past this
+
+    struct ThreadBuffer {
+        uint32_t index = 0;
+        std::string name;
+        std::unique_ptr<ProfileEvent[]> events{new ProfileEvent[RING_CAPACITY]};
+        std::atomic<uint64_t> writePos{0};  // Advanced by the owning thread only
+        std::atomic<uint64_t> readPos{0};   // Advanced by collect() only
+        std::atomic<uint64_t> dropped{0};
+    };
+
+    static std::chrono::steady_clock::time_point epoch();
+    ThreadBuffer& localBuffer();
+    void collectLocked();
+
+    std::atomic<bool> enabled;
+    static std::atomic<Profiler*> constructed;
+    std::vector<std::shared_ptr<ThreadBuffer>> threads;
+    std::deque<ProfileEvent> history;
+    std::deque<std::pair<std::string, ProfileZone>> internedZones;
+    mutable std::mutex profilerMutex;
+};
+
+// Times its lifetime as one event of zone
+class ProfileScope {
+public:
+    explicit ProfileScope(const ProfileZone& zone) {
+        if (Profiler::getInstance().isEnabled()) {
+            this->zone = &zone;
+            depth = currentDepth()++;
+            start = Profiler::now();
+        }
+    }
+
+    ~ProfileScope() {
+        if (zone) {
+            uint64_t end = Profiler::now();
+            currentDepth()--;
+            Profiler::getInstance().record(zone, start, end, depth);
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+    static uint32_t& currentDepth() {
+        static thread_local uint32_t depth = 0;
+        return depth;
+    }
+
+private:
+    const ProfileZone* zone = nullptr;
+    uint64_t start = 0;
+    uint32_t depth = 0;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE_CATEGORY(name, category) \
+    static constexpr ProfileZone PROFILE_CONCAT(profileZone_, __LINE__){name, category, __FILE__, __LINE__}; \
+    ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(PROFILE_CONCAT(profileZone_, __LINE__))
+#define PROFILE_SCOPE(name) PROFILE_SCOPE_CATEGORY(name, "engine")
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+
+/*
+ * SamplingProfiler.h
+ *
+ * Always-on statistical profiler that needs no instrumentation. A CPU-time
+ * interval timer (ITIMER_PROF) raises SIGPROF in whichever thread is running;
+ * the handler walks the frame-pointer chain (the engine builds with
+ * -fno-omit-frame-pointer) and appends the return addresses to a lock-free
+ * ring. A collector thread folds the ring into per-stack counts, and
+ * writeFoldedStacks() symbolizes the addresses with dladdr and writes
+ * "root;caller;leaf count" lines for flamegraph.pl or speedscope.
+ *
+ * The handler's own run time is measured, so getOverhead() reports the share
+ * of process CPU time spent sampling. Linux only; start() fails elsewhere.
+ */
+
+class SamplingProfiler {
+public:
+    static SamplingProfiler& getInstance();
+
+    bool start(int rateHz);
+    void stop();
+    bool isRunning() const { return running.load(std::memory_order_relaxed); }
+
+    // Moves finished samples from the ring into the aggregated stacks
+    void collect();
+    bool writeFoldedStacks(const std::string& path);
+    void clear();
+
+    uint64_t getSampleCount() const;
+    uint64_t getDroppedSampleCount() const { return dropped.load(std::memory_order_relaxed); }
+    double getOverhead() const;  // Handler CPU time / process CPU time since start()
+
+    // Called from the signal handler only
+    void recordSample(const uintptr_t* frames, uint32_t depth);
+    void addHandlerTime(uint64_t nanos);
+
+    static constexpr uint32_t MAX_DEPTH = 64;
+
+    // Function name for a return address, else module+offset, else the raw address
+    static std::string symbolize(uintptr_t address);
+
+private:
+    SamplingProfiler();
+    ~SamplingProfiler();
+    SamplingProfiler(const SamplingProfiler&) = delete;
+    SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+
+    static constexpr size_t RING_WORDS = size_t(1) << 20;  // 8 MB of samples between collects
+
+    void collectorLoop();
+
+    // Ring of variable-length records: a header word (frame count + flags),
+    // then the frames leaf first. Writers reserve space with a CAS on
+    // writeCursor and publish by storing the header last.
+    std::unique_ptr<std::atomic<uint64_t>[]> ring;
+    std::atomic<uint64_t> writeCursor{0};
+    std::atomic<uint64_t> readCursor{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> handlerNanos{0};
+    std::atomic<bool> running{false};
+
+    std::map<std::vector<uintptr_t>, uint64_t> stacks;  // Leaf-first frames -> samples
+    uint64_t collected = 0;
+    uint64_t startCpuNanos = 0;
+    mutable std::mutex profilerMutex;
+
+    std::thread collector;
+    std::mutex collectorMutex;
+    std::condition_variable collectorCondition;
+};
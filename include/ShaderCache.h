@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string_view>
+#include "glad/glad.h"
+
+/*
+ * ShaderCache.h
+ *
+ * Persists linked GL programs as driver binaries in the DerivedAssetCache.
+ * Binaries are keyed by the shader sources and the GL vendor, renderer and
+ * version strings, so a driver update or a shader edit is a plain miss.
+ * Needs GL 4.1 (glProgramBinary); on older contexts every call is a miss.
+ *
+ * Usage:
+ *   GLuint program = ShaderCache::loadProgram(vs, fs);
+ *   if (program == 0) {
+ *       program = glCreateProgram();
+ *       ... attach shaders ...
+ *       ShaderCache::prepareProgram(program);
+ *       glLinkProgram(program);
+ *       ShaderCache::storeProgram(program, vs, fs);
+ *   }
+ */
+
+class ShaderCache {
+public:
+    static bool isSupported();
+
+    // Linked program restored from a cached binary, or 0 on a miss
+    static GLuint loadProgram(std::string_view vertexSource, std::string_view fragmentSource);
+
+    // Call between glCreateProgram and glLinkProgram so the driver keeps the binary
+    static void prepareProgram(GLuint program);
+
+    // Saves a successfully linked program; does nothing if the link failed
+    static void storeProgram(GLuint program, std::string_view vertexSource, std::string_view fragmentSource);
+};
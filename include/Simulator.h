@@ -3,12 +3,22 @@
 
 class Simulator {
 public:
+    // Hardware counter figures for the last step; zero when counters are off
+    struct StepCounters {
+        double ipc = 0.0;
+        double l1dMissesPerBody = 0.0;
+        double llcMissesPerBody = 0.0;
+        double branchMissesPerBody = 0.0;
+    };
+
     Simulator(World& world);
     void step(double dt);
     void clear();
+    const StepCounters& getStepCounters() const { return stepCounters; }
 
 private:
     World& world;
+    StepCounters stepCounters;
     void calculateForces();
     void updatePositions(double dt);
 }; 
\ No newline at end of file
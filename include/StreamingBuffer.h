@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include "glad/glad.h"
+
+/*
+ * StreamingBuffer.h
+ *
+ * Ring buffer for vertex and instance data rewritten every frame. Each
+ * upload() appends to the ring and returns the byte offset to draw from, so
+ * a write never touches storage a queued draw may still be reading.
+ *
+ * With buffer storage (GL 4.4 / ARB_buffer_storage) the ring is mapped once,
+ * persistently and coherently, and uploads are a memcpy. endFrame() fences
+ * the frame's region, and the ring only waits on that fence when it comes
+ * back around to it a lap later. Without it, uploads use glBufferSubData
+ * into untouched ranges and the buffer is orphaned each time the ring wraps.
+ *
+ * Usage (context current):
+ *   StreamingBuffer stream(1 << 20);
+ *   GLintptr offset = stream.upload(vertices.data(), bytes);
+ *   glBindBuffer(GL_ARRAY_BUFFER, stream.buffer());
+ *   glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride, (void*)offset);
+ *   glDrawArrays(...);
+ *   stream.endFrame();  // After the draws that read this frame's uploads
+ *
+ * A frame that outgrows the ring moves it to a larger buffer, which changes
+ * buffer() and drops earlier uploads of that frame; draw each upload before
+ * the next, or size the ring for a whole frame.
+ */
+
+class StreamingBuffer {
+public:
+    explicit StreamingBuffer(GLsizeiptr capacity);
+    ~StreamingBuffer();
+    StreamingBuffer(const StreamingBuffer&) = delete;
+    StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+
+    static bool isPersistentMappingSupported();
+
+    // Copies size bytes into the ring; returns their offset in buffer().
+    // May change the GL_ARRAY_BUFFER binding
+    GLintptr upload(const void* data, GLsizeiptr size, GLsizeiptr alignment = 16);
+    void endFrame();
+
+    GLuint buffer() const { return bufferId; }
+    GLsizeiptr getCapacity() const { return capacity; }
+    bool isPersistent() const { return mapped != nullptr; }
+    size_t getStallCount() const { return stallCount; }  // Uploads that waited on the GPU
+    size_t getGrowCount() const { return growCount; }
+
+private:
+    struct Region {
+        GLsync fence;
+        GLintptr begin;
+        GLsizeiptr size;  // begin + size may pass the end of the ring and wrap
+    };
+
+    void create(GLsizeiptr newCapacity);
+    void destroy();
+    void waitForRange(GLintptr begin, GLintptr end);  // Persistent rings only
+
+    GLuint bufferId = 0;
+    GLsizeiptr capacity = 0;
+    char* mapped = nullptr;  // Persistent mapping, or null when orphaning
+    GLintptr head = 0;       // Next free byte
+    GLintptr frameStart = 0;
+    GLsizeiptr frameBytes = 0;  // Written or skipped since the last endFrame
+    std::deque<Region> inFlight;  // Oldest first; directly ahead of head
+    size_t stallCount = 0;
+    size_t growCount = 0;
+};
@@ -24,6 +24,8 @@ public:
     
     // Mesh management
     void addMesh(const std::string& name, const Mesh& mesh);
+    // Adds the finest LOD of a MeshFile (.mesh), or imports an OBJ/glTF model
+    bool loadMesh(const std::string& name, const std::string& path);
     const Mesh* getMesh(const std::string& name) const;
     Mesh* getMesh(const std::string& name);
     
@@ -0,0 +1,377 @@
+#include "AllocationTracker.h"
+#include "EngineBackend.h"
+#include "EngineConfig.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <execinfo.h>
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#define NOGDI
+#include <windows.h>
+#endif
+
+namespace {
+constexpr size_t TAG_COUNT = static_cast<size_t>(AllocationTag::Count);
+constexpr int MAX_STACK_DEPTH = 32;
+constexpr size_t MAX_REPORTED_STACKS = 256;
+
+// Touched by operator new before any constructor may have run, so everything
+// here is constant-initialized
+struct alignas(64) TagCounters {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> frees{0};
+};
+
+TagCounters tagCounters[TAG_COUNT];
+std::atomic<bool> hotPathArmed{false};
+std::atomic<bool> abortOnHotPath{false};
+std::atomic<uint64_t> hotPathViolations{0};
+
+thread_local AllocationTag currentTag = AllocationTag::General;
+thread_local uint32_t hotPathDepth = 0;
+thread_local bool reporting = false;  // The report's own allocations are not counted
+
+int captureStack(void** frames, int maxDepth) {
+#if defined(__GLIBC__)
+    return backtrace(frames, maxDepth);
+#elif defined(_WIN32)
+    return static_cast<int>(CaptureStackBackTrace(0, static_cast<DWORD>(maxDepth), frames, nullptr));
+#else
+    (void)frames;
+    (void)maxDepth;
+    return 0;
+#endif
+}
+
+// Reports are logged from endFrame(): the allocation being reported may come
+// from inside the Logger, with its mutex held
+struct ReportState {
+    std::mutex mutex;
+    std::unordered_set<uint64_t> reportedStacks;
+    std::vector<std::string> pendingReports;
+};
+
+ReportState& reportState() {
+    // Leaked so a late allocation during shutdown never finds it destroyed
+    static ReportState* state = new ReportState();
+    return *state;
+}
+
+void reportHotPathAllocation(size_t size) {
+    reporting = true;
+    hotPathViolations.fetch_add(1, std::memory_order_relaxed);
+
+    void* frames[MAX_STACK_DEPTH];
+    int depth = captureStack(frames, MAX_STACK_DEPTH);
+    uint64_t hash = 14695981039346656037ull;
+    for (int i = 0; i < depth; ++i) {
+        hash = (hash ^ reinterpret_cast<uintptr_t>(frames[i])) * 1099511628211ull;
+    }
+
+    ReportState& state = reportState();
+    bool firstReport;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        firstReport = state.reportedStacks.size() < MAX_REPORTED_STACKS && state.reportedStacks.insert(hash).second;
+    }
+    bool abortNow = abortOnHotPath.load(std::memory_order_relaxed);
+
+    if (firstReport || abortNow) {
+        std::stringstream ss;
+        ss << "Heap allocation of " << size << " bytes on the "
+           << AllocationTracker::getTagName(currentTag) << " hot path after warm-up:";
+#if defined(__GLIBC__)
+        if (char** symbols = backtrace_symbols(frames, depth)) {
+            for (int i = 0; i < depth; ++i) {
+                ss << "\n    " << symbols[i];
+            }
+            std::free(symbols);
+        }
+#else
+        for (int i = 0; i < depth; ++i) {
+            ss << "\n    " << frames[i];
+        }
+#endif
+        if (abortNow) {
+            // The Logger may be the one allocating, so write directly
+            std::fprintf(stderr, "%s\nAborting: debug.allocations.abort_on_hot_path is set\n", ss.str().c_str());
+            std::abort();
+        }
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.pendingReports.push_back(ss.str());
+    }
+    reporting = false;
+}
+
+inline void noteAllocation(size_t size) {
+    if (reporting) {
+        return;
+    }
+    TagCounters& counters = tagCounters[static_cast<size_t>(currentTag)];
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes.fetch_add(size, std::memory_order_relaxed);
+    if (hotPathDepth && hotPathArmed.load(std::memory_order_relaxed)) {
+        reportHotPathAllocation(size);
+    }
+}
+
+inline void noteFree() {
+    if (reporting) {
+        return;
+    }
+    tagCounters[static_cast<size_t>(currentTag)].frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+void* allocate(size_t size) {
+    size = std::max<size_t>(size, 1);
+    for (;;) {
+        if (void* memory = std::malloc(size)) {
+            noteAllocation(size);
+            return memory;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* allocateAligned(size_t size, size_t alignment) {
+    size = std::max<size_t>(size, 1);
+    for (;;) {
+#ifdef _WIN32
+        void* memory = _aligned_malloc(size, alignment);
+#else
+        void* memory = nullptr;
+        if (posix_memalign(&memory, std::max(alignment, sizeof(void*)), size) != 0) {
+            memory = nullptr;
+        }
+#endif
+        if (memory) {
+            noteAllocation(size);
+            return memory;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void release(void* memory) {
+    if (memory) {
+        noteFree();
+        std::free(memory);
+    }
+}
+
+void releaseAligned(void* memory) {
+    if (memory) {
+        noteFree();
+#ifdef _WIN32
+        _aligned_free(memory);
+#else
+        std::free(memory);
+#endif
+    }
+}
+
+AllocationStats loadStats(AllocationTag tag) {
+    const TagCounters& counters = tagCounters[static_cast<size_t>(tag)];
+    AllocationStats stats;
+    stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+    stats.bytes = counters.bytes.load(std::memory_order_relaxed);
+    stats.frees = counters.frees.load(std::memory_order_relaxed);
+    return stats;
+}
+}
+
+// Global allocation hooks
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocateAligned(size, static_cast<size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocateAligned(size, static_cast<size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return allocate(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return allocate(size); } catch (...) { return nullptr; }
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return allocateAligned(size, static_cast<size_t>(alignment)); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return allocateAligned(size, static_cast<size_t>(alignment)); } catch (...) { return nullptr; }
+}
+
+void operator delete(void* memory) noexcept { release(memory); }
+void operator delete[](void* memory) noexcept { release(memory); }
+void operator delete(void* memory, std::size_t) noexcept { release(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { release(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { release(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { release(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { releaseAligned(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { releaseAligned(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { releaseAligned(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { releaseAligned(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(memory); }
+
+// AllocationTracker Implementation
+AllocationTracker& AllocationTracker::getInstance() {
+    static AllocationTracker instance;
+    return instance;
+}
+
+AllocationTracker::AllocationTracker() : frameCount(0), warmupFrames(0), checkingEnabled(false) {
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        frameStart[i] = loadStats(static_cast<AllocationTag>(i));
+    }
+    EngineConfig& config = EngineConfig::getInstance();
+    setHotPathChecking(config.isHotPathAllocationCheckEnabled(),
+                       static_cast<uint32_t>(std::max(config.getAllocationWarmupFrames(), 0)),
+                       config.isAbortOnHotPathAllocation());
+}
+
+AllocationTracker::~AllocationTracker() {
+    hotPathArmed.store(false, std::memory_order_relaxed);
+}
+
+const char* AllocationTracker::getTagName(AllocationTag tag) {
+    switch (tag) {
+        case AllocationTag::General: return "general";
+        case AllocationTag::Physics: return "physics";
+        case AllocationTag::Render: return "render";
+        case AllocationTag::IO: return "io";
+        default: return "unknown";
+    }
+}
+
+AllocationStats AllocationTracker::getStats(AllocationTag tag) const {
+    return loadStats(tag);
+}
+
+AllocationStats AllocationTracker::getTotalStats() const {
+    AllocationStats total;
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        AllocationStats stats = loadStats(static_cast<AllocationTag>(i));
+        total.allocations += stats.allocations;
+        total.bytes += stats.bytes;
+        total.frees += stats.frees;
+    }
+    return total;
+}
+
+AllocationStats AllocationTracker::getLastFrameStats(AllocationTag tag) const {
+    std::lock_guard<std::mutex> lock(trackerMutex);
+    return lastFrame[static_cast<size_t>(tag)];
+}
+
+AllocationStats AllocationTracker::getLastFrameTotalStats() const {
+    std::lock_guard<std::mutex> lock(trackerMutex);
+    AllocationStats total;
+    for (const AllocationStats& stats : lastFrame) {
+        total.allocations += stats.allocations;
+        total.bytes += stats.bytes;
+        total.frees += stats.frees;
+    }
+    return total;
+}
+
+void AllocationTracker::endFrame() {
+    bool armNow;
+    {
+        std::lock_guard<std::mutex> lock(trackerMutex);
+        for (size_t i = 0; i < TAG_COUNT; ++i) {
+            AllocationStats current = loadStats(static_cast<AllocationTag>(i));
+            lastFrame[i].allocations = current.allocations - frameStart[i].allocations;
+            lastFrame[i].bytes = current.bytes - frameStart[i].bytes;
+            lastFrame[i].frees = current.frees - frameStart[i].frees;
+            frameStart[i] = current;
+        }
+        frameCount++;
+        armNow = checkingEnabled && frameCount >= warmupFrames && !hotPathArmed.load(std::memory_order_relaxed);
+    }
+    if (armNow) {
+        hotPathArmed.store(true, std::memory_order_relaxed);
+        LOG_INFO("Hot-path allocation checking armed after " + std::to_string(frameCount) + " frames");
+    }
+
+    std::vector<std::string> reports;
+    {
+        ReportState& state = reportState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        reports.swap(state.pendingReports);
+    }
+    for (const std::string& report : reports) {
+        LOG_WARNING(report);
+    }
+}
+
+uint64_t AllocationTracker::getFrameCount() const {
+    std::lock_guard<std::mutex> lock(trackerMutex);
+    return frameCount;
+}
+
+void AllocationTracker::setHotPathChecking(bool enabled, uint32_t warmup, bool abortOnViolation) {
+    std::lock_guard<std::mutex> lock(trackerMutex);
+    checkingEnabled = enabled;
+    warmupFrames = warmup;
+    abortOnHotPath.store(abortOnViolation, std::memory_order_relaxed);
+    hotPathArmed.store(enabled && frameCount >= warmupFrames && frameCount > 0, std::memory_order_relaxed);
+}
+
+bool AllocationTracker::isHotPathChecking() const {
+    return hotPathArmed.load(std::memory_order_relaxed);
+}
+
+uint64_t AllocationTracker::getHotPathViolationCount() const {
+    return hotPathViolations.load(std::memory_order_relaxed);
+}
+
+std::string AllocationTracker::getReport() const {
+    std::stringstream ss;
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        AllocationTag tag = static_cast<AllocationTag>(i);
+        AllocationStats total = getStats(tag);
+        AllocationStats frame = getLastFrameStats(tag);
+        ss << getTagName(tag) << ": allocations=" << total.allocations << " bytes=" << total.bytes
+           << " frees=" << total.frees << " last_frame_allocations=" << frame.allocations
+           << " last_frame_bytes=" << frame.bytes << "\n";
+    }
+    ss << "hot_path_violations=" << getHotPathViolationCount() << "\n";
+    return ss.str();
+}
+
+// AllocationScope Implementation
+AllocationScope::AllocationScope(AllocationTag tag, bool hotPath)
+    : previousTag(currentTag), hotPath(hotPath) {
+    currentTag = tag;
+    if (hotPath) {
+        hotPathDepth++;
+    }
+}
+
+AllocationScope::~AllocationScope() {
+    currentTag = previousTag;
+    if (hotPath) {
+        hotPathDepth--;
+    }
+}
@@ -0,0 +1,296 @@
+#include "AssetPack.h"
+#include <algorithm>
+#include <cstring>
+
+static_assert(sizeof(AssetPack::PackHeader) == 32, "PackHeader layout is part of the file format");
+static_assert(sizeof(AssetPack::PackEntry) == 40, "PackEntry layout is part of the file format");
+
+namespace {
+constexpr size_t HASH_BITS = 14;
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t MAX_OFFSET = 65535;
+// Matches never run into the last bytes, which keeps the decoder's final sequence literal-only
+constexpr size_t END_LITERALS = 5;
+constexpr size_t MATCH_SEARCH_LIMIT = 12;
+
+uint32_t read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+void writeLength(std::vector<uint8_t>& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+void emitSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalLength,
+                  size_t offset, size_t matchLength) {
+    size_t matchCode = matchLength >= MIN_MATCH ? matchLength - MIN_MATCH : 0;
+    uint8_t token = static_cast<uint8_t>((std::min<size_t>(literalLength, 15) << 4) |
+                                         std::min<size_t>(matchCode, 15));
+    out.push_back(token);
+    if (literalLength >= 15) {
+        writeLength(out, literalLength - 15);
+    }
+    out.insert(out.end(), literals, literals + literalLength);
+    if (matchLength == 0) {
+        return;  // Final literal-only sequence
+    }
+    out.push_back(static_cast<uint8_t>(offset & 0xFF));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (matchCode >= 15) {
+        writeLength(out, matchCode - 15);
+    }
+}
+
+bool readLength(const uint8_t*& in, const uint8_t* end, size_t& length) {
+    uint8_t byte;
+    do {
+        if (in >= end) return false;
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+template<typename T>
+void append(std::vector<uint8_t>& out, const T& value) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+}
+
+std::vector<uint8_t> AssetPack::compress(const uint8_t* data, size_t size) {
+    std::vector<uint8_t> out;
+    out.reserve(size / 2 + 16);
+    std::vector<uint32_t> table(size_t(1) << HASH_BITS, 0);  // Position + 1, 0 = empty
+
+    size_t anchor = 0;
+    size_t i = 0;
+    size_t limit = size > MATCH_SEARCH_LIMIT ? size - MATCH_SEARCH_LIMIT : 0;
+    while (i < limit) {
+        uint32_t sequence = read32(data + i);
+        uint32_t hash = (sequence * 2654435761u) >> (32 - HASH_BITS);
+        size_t candidate = table[hash];
+        table[hash] = static_cast<uint32_t>(i + 1);
+        if (candidate == 0 || i - (candidate - 1) > MAX_OFFSET || read32(data + candidate - 1) != sequence) {
+            i++;
+            continue;
+        }
+        size_t match = candidate - 1;
+        size_t length = MIN_MATCH;
+        while (i + length < size - END_LITERALS && data[match + length] == data[i + length]) {
+            length++;
+        }
+        emitSequence(out, data + anchor, i - anchor, i - match, length);
+        i += length;
+        anchor = i;
+    }
+    emitSequence(out, data + anchor, size - anchor, 0, 0);
+    return out;
+}
+
+bool AssetPack::decompress(const uint8_t* data, size_t size, uint8_t* output, size_t outputSize) {
+    const uint8_t* in = data;
+    const uint8_t* end = data + size;
+    size_t produced = 0;
+    while (in < end) {
+        uint8_t token = *in++;
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(in, end, literalLength)) return false;
+        if (literalLength > static_cast<size_t>(end - in) || literalLength > outputSize - produced) return false;
+        std::memcpy(output + produced, in, literalLength);
+        in += literalLength;
+        produced += literalLength;
+        if (in == end) {
+            break;  // Final sequence carries literals only
+        }
+
+        if (end - in < 2) return false;
+        size_t offset = in[0] | (size_t(in[1]) << 8);
+        in += 2;
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(in, end, matchLength)) return false;
+        matchLength += MIN_MATCH;
+        if (offset == 0 || offset > produced || matchLength > outputSize - produced) return false;
+        // Byte-wise copy: matches may overlap the bytes they produce
+        const uint8_t* from = output + produced - offset;
+        for (size_t k = 0; k < matchLength; ++k) {
+            output[produced + k] = from[k];
+        }
+        produced += matchLength;
+    }
+    return produced == outputSize;
+}
+
+std::string AssetPack::normalizePath(std::string_view path) {
+    std::string normalized(path);
+    std::replace(normalized.begin(), normalized.end(), '\\', '/');
+    while (normalized.compare(0, 2, "./") == 0) {
+        normalized.erase(0, 2);
+    }
+    return normalized;
+}
+
+bool AssetPack::open(const std::string& path) {
+    close();
+    if (!file.open(path, AccessHint::Random)) {
+        return false;
+    }
+    PackHeader header;
+    if (file.size() < sizeof(header)) {
+        LOG_ERROR("Asset pack too small: " + path);
+        close();
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    size_t indexEnd = header.indexOffset + size_t(header.entryCount) * sizeof(PackEntry);
+    if (header.magic != MAGIC || header.version != VERSION ||
+        indexEnd > file.size() || header.stringsOffset > file.size() ||
+        header.indexOffset % alignof(PackEntry) != 0) {
+        LOG_ERROR("Invalid asset pack: " + path);
+        close();
+        return false;
+    }
+    entries = reinterpret_cast<const PackEntry*>(file.data() + header.indexOffset);
+    entryCount = header.entryCount;
+    strings = file.view(header.stringsOffset, file.size() - header.stringsOffset);
+    // The index is tiny and touched on every lookup; prefetch it
+    file.advise(AccessHint::WillNeed, header.indexOffset, indexEnd - header.indexOffset);
+    return true;
+}
+
+void AssetPack::close() {
+    file.close();
+    entries = nullptr;
+    entryCount = 0;
+    strings = {};
+}
+
+std::string_view AssetPack::entryPath(const PackEntry& entry) const {
+    if (entry.pathOffset > strings.size()) {
+        return {};
+    }
+    return strings.substr(entry.pathOffset, entry.pathLength);
+}
+
+const AssetPack::PackEntry* AssetPack::find(std::string_view path) const {
+    if (!entries) {
+        return nullptr;
+    }
+    const PackEntry* end = entries + entryCount;
+    const PackEntry* it = std::lower_bound(entries, end, path,
+        [this](const PackEntry& entry, std::string_view key) {
+            return entryPath(entry) < key;
+        });
+    return (it != end && entryPath(*it) == path) ? it : nullptr;
+}
+
+bool AssetPack::contains(std::string_view path) const {
+    return find(normalizePath(path)) != nullptr;
+}
+
+std::optional<std::string_view> AssetPack::read(std::string_view path, std::vector<uint8_t>& scratch) const {
+    const PackEntry* entry = find(normalizePath(path));
+    if (!entry || entry->dataOffset > file.size() || entry->storedSize > file.size() - entry->dataOffset) {
+        return std::nullopt;
+    }
+    const uint8_t* stored = file.data() + entry->dataOffset;
+    if (!(entry->flags & ENTRY_COMPRESSED)) {
+        return std::string_view(reinterpret_cast<const char*>(stored), entry->storedSize);
+    }
+    scratch.resize(entry->originalSize);
+    if (!decompress(stored, entry->storedSize, scratch.data(), scratch.size())) {
+        LOG_ERROR("Corrupt asset pack entry: " + std::string(path));
+        return std::nullopt;
+    }
+    return std::string_view(reinterpret_cast<const char*>(scratch.data()), scratch.size());
+}
+
+bool AssetPack::build(const std::string& outputPath,
+                      const std::vector<std::pair<std::string, std::string>>& files,
+                      bool compressEntries) {
+    struct Staged {
+        std::string path;
+        std::vector<uint8_t> data;
+        uint64_t originalSize;
+        uint32_t flags;
+    };
+    // Read every source in one batch rather than one blocking read at a time
+    std::vector<std::string> sourcePaths;
+    sourcePaths.reserve(files.size());
+    for (const auto& file : files) {
+        sourcePaths.push_back(file.second);
+    }
+    std::vector<std::vector<uint8_t>> sources;
+    if (!FileSystem::getInstance().loadFiles(sourcePaths, sources)) {
+        return false;
+    }
+
+    std::vector<Staged> staged;
+    staged.reserve(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        Staged item{normalizePath(files[i].first), std::move(sources[i]), 0, 0};
+        item.originalSize = item.data.size();
+        if (compressEntries && !item.data.empty()) {
+            std::vector<uint8_t> packed = compress(item.data.data(), item.data.size());
+            // Only keep compression that pays for the decode
+            if (packed.size() < item.data.size() - item.data.size() / 8) {
+                item.data = std::move(packed);
+                item.flags |= ENTRY_COMPRESSED;
+            }
+        }
+        staged.push_back(std::move(item));
+    }
+    std::sort(staged.begin(), staged.end(), [](const Staged& a, const Staged& b) { return a.path < b.path; });
+    for (size_t i = 1; i < staged.size(); ++i) {
+        if (staged[i].path == staged[i - 1].path) {
+            LOG_ERROR("Duplicate asset pack path: " + staged[i].path);
+            return false;
+        }
+    }
+
+    PackHeader header{MAGIC, VERSION, static_cast<uint32_t>(staged.size()), 0, 0, 0};
+    header.indexOffset = sizeof(PackHeader);
+    header.stringsOffset = header.indexOffset + staged.size() * sizeof(PackEntry);
+
+    std::string stringTable;
+    std::vector<PackEntry> index;
+    index.reserve(staged.size());
+    for (const Staged& item : staged) {
+        PackEntry entry{};
+        entry.pathOffset = static_cast<uint32_t>(stringTable.size());
+        entry.pathLength = static_cast<uint32_t>(item.path.size());
+        entry.storedSize = item.data.size();
+        entry.originalSize = item.originalSize;
+        entry.flags = item.flags;
+        stringTable += item.path;
+        index.push_back(entry);
+    }
+
+    auto align = [](uint64_t offset) {
+        return (offset + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+    };
+    uint64_t dataOffset = align(header.stringsOffset + stringTable.size());
+    for (PackEntry& entry : index) {
+        entry.dataOffset = dataOffset;
+        dataOffset = align(dataOffset + entry.storedSize);
+    }
+
+    std::vector<uint8_t> output;
+    output.reserve(dataOffset);
+    append(output, header);
+    for (const PackEntry& entry : index) {
+        append(output, entry);
+    }
+    output.insert(output.end(), stringTable.begin(), stringTable.end());
+    for (size_t i = 0; i < staged.size(); ++i) {
+        output.resize(index[i].dataOffset, 0);
+        output.insert(output.end(), staged[i].data.begin(), staged[i].data.end());
+    }
+    return FileSystem::getInstance().saveFile(outputPath, output);
+}
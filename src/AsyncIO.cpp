@@ -0,0 +1,608 @@
+#include "AsyncIO.h"
+#include "EngineBackend.h"
+#include "Profiler.h"
+#include "AllocationTracker.h"
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <thread>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define ASYNCIO_HAS_IO_URING 1
+#endif
+#endif
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#ifdef ASYNCIO_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+struct AsyncIO::Operation {
+    IORequest request;
+    std::shared_ptr<CompletionCallback> callback;
+    int fd = -1;
+    size_t transferred = 0;
+    int error = 0;
+#ifdef ASYNCIO_HAS_IO_URING
+    struct iovec iov;
+#endif
+
+    ~Operation() {
+        closeFile();
+    }
+
+    void closeFile() {
+#ifndef _WIN32
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+#endif
+    }
+};
+
+#ifdef ASYNCIO_HAS_IO_URING
+// Minimal io_uring wrapper over the raw syscalls, so there is no liburing dependency
+class AsyncIO::Ring {
+public:
+    static std::unique_ptr<Ring> create(unsigned entries) {
+        std::unique_ptr<Ring> ring(new Ring());
+        if (!ring->setup(entries)) {
+            return nullptr;
+        }
+        return ring;
+    }
+
+    ~Ring() {
+        if (sqes) munmap(sqes, sqesSize);
+        if (cqPtr && cqPtr != sqPtr) munmap(cqPtr, cqSize);
+        if (sqPtr) munmap(sqPtr, sqSize);
+        if (ringFd >= 0) close(ringFd);
+    }
+
+    // Fills an SQE for the remaining part of op; false when the rings are full
+    bool push(Operation* op) {
+        unsigned tail = *sqTail;
+        unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+        // Never put more in flight than the completion ring can hold
+        if (tail - head >= sqEntries || inRing >= cqEntries) {
+            return false;
+        }
+        unsigned index = tail & *sqMask;
+        io_uring_sqe* sqe = &sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+
+        const IORequest& request = op->request;
+        bool isRead = request.operation == IOOperation::Read;
+        uint8_t* address = request.buffer + op->transferred;
+        size_t remaining = request.length - op->transferred;
+        sqe->fd = op->fd;
+        sqe->off = request.offset + op->transferred;
+        sqe->user_data = reinterpret_cast<uint64_t>(op);
+        if (request.registeredBuffer >= 0) {
+            sqe->opcode = isRead ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+            sqe->addr = reinterpret_cast<uint64_t>(address);
+            sqe->len = static_cast<uint32_t>(remaining);
+            sqe->buf_index = static_cast<uint16_t>(request.registeredBuffer);
+        } else {
+            op->iov.iov_base = address;
+            op->iov.iov_len = remaining;
+            sqe->opcode = isRead ? IORING_OP_READV : IORING_OP_WRITEV;
+            sqe->addr = reinterpret_cast<uint64_t>(&op->iov);
+            sqe->len = 1;
+        }
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        toSubmit++;
+        inRing++;
+        return true;
+    }
+
+    // Submits pushed SQEs and optionally blocks for minComplete completions.
+    // Returns 0 or an errno; whatever the kernel did not take stays pushed
+    int enter(unsigned minComplete) {
+        if (toSubmit == 0 && minComplete == 0) {
+            return 0;
+        }
+        unsigned flags = minComplete > 0 ? IORING_ENTER_GETEVENTS : 0;
+        long result = syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0);
+        if (result < 0) {
+            return errno;
+        }
+        toSubmit -= static_cast<unsigned>(result);
+        return 0;
+    }
+
+    bool hasUnsubmitted() const { return toSubmit > 0; }
+
+    // Takes back the SQEs the kernel has not consumed yet, oldest first
+    template<typename F>
+    void dropUnsubmitted(F&& onOperation) {
+        unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+        unsigned tail = *sqTail;
+        for (unsigned i = head; i != tail; ++i) {
+            onOperation(reinterpret_cast<Operation*>(sqes[sqArray[i & *sqMask]].user_data));
+        }
+        __atomic_store_n(sqTail, head, __ATOMIC_RELEASE);
+        inRing -= tail - head;
+        toSubmit = 0;
+    }
+
+    // Blocks until a completion is ready without submitting anything, so it
+    // touches no submission state and may run without the owner's lock
+    void waitForCompletion() const {
+        syscall(__NR_io_uring_enter, ringFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+    }
+
+    template<typename F>
+    void reap(F&& onCompletion) {
+        unsigned head = *cqHead;
+        unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        while (head != tail) {
+            const io_uring_cqe& cqe = cqes[head & *cqMask];
+            onCompletion(reinterpret_cast<Operation*>(cqe.user_data), cqe.res);
+            head++;
+            inRing--;
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    }
+
+    bool registerBuffers(const std::vector<std::pair<uint8_t*, size_t>>& buffers) {
+        std::vector<struct iovec> iovecs(buffers.size());
+        for (size_t i = 0; i < buffers.size(); ++i) {
+            iovecs[i].iov_base = buffers[i].first;
+            iovecs[i].iov_len = buffers[i].second;
+        }
+        return syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_BUFFERS,
+                       iovecs.data(), static_cast<unsigned>(iovecs.size())) == 0;
+    }
+
+    void unregisterBuffers() {
+        syscall(__NR_io_uring_register, ringFd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+    }
+
+private:
+    Ring() = default;
+
+    bool setup(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        ringFd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (ringFd < 0) {
+            return false;
+        }
+
+        sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMap) {
+            sqSize = cqSize = std::max(sqSize, cqSize);
+        }
+        sqPtr = mmap(nullptr, sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+        if (sqPtr == MAP_FAILED) {
+            sqPtr = nullptr;
+            return false;
+        }
+        if (singleMap) {
+            cqPtr = sqPtr;
+        } else {
+            cqPtr = mmap(nullptr, cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+            if (cqPtr == MAP_FAILED) {
+                cqPtr = nullptr;
+                return false;
+            }
+        }
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqeMemory = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+        if (sqeMemory == MAP_FAILED) {
+            return false;
+        }
+        sqes = static_cast<io_uring_sqe*>(sqeMemory);
+
+        auto* sq = static_cast<uint8_t*>(sqPtr);
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        sqEntries = params.sq_entries;
+
+        auto* cq = static_cast<uint8_t*>(cqPtr);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        cqEntries = params.cq_entries;
+        return true;
+    }
+
+    int ringFd = -1;
+    void* sqPtr = nullptr;
+    void* cqPtr = nullptr;
+    size_t sqSize = 0;
+    size_t cqSize = 0;
+    io_uring_sqe* sqes = nullptr;
+    size_t sqesSize = 0;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqMask = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned sqEntries = 0;
+
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned* cqMask = nullptr;
+    io_uring_cqe* cqes = nullptr;
+    unsigned cqEntries = 0;
+
+    unsigned toSubmit = 0;
+    unsigned inRing = 0;
+};
+#else
+class AsyncIO::Ring {};
+#endif
+
+namespace {
+constexpr unsigned RING_ENTRIES = 256;
+// Rounds deliver() retries SQEs the kernel turned away (EAGAIN, EBUSY) before failing them
+constexpr unsigned MAX_SUBMIT_RETRIES = 64;
+
+bool isTransientSubmitError(int error) {
+    return error == EINTR || error == EAGAIN || error == EBUSY;
+}
+}
+
+AsyncIO& AsyncIO::getInstance() {
+    static AsyncIO instance;
+    return instance;
+}
+
+AsyncIO::AsyncIO() : inFlight(0) {
+#ifdef ASYNCIO_HAS_IO_URING
+    ring = Ring::create(RING_ENTRIES);
+#endif
+    if (ring) {
+        LOG_INFO("AsyncIO using io_uring backend");
+    } else {
+        LOG_INFO("AsyncIO using thread pool backend");
+    }
+}
+
+AsyncIO::~AsyncIO() {
+    waitAll();
+}
+
+bool AsyncIO::isUsingIOUring() const {
+    return ring != nullptr;
+}
+
+bool AsyncIO::registerBuffers(const std::vector<std::pair<uint8_t*, size_t>>& buffers) {
+    std::lock_guard<std::mutex> lock(ioMutex);
+#ifdef ASYNCIO_HAS_IO_URING
+    if (ring) {
+        if (!registeredBuffers.empty()) {
+            ring->unregisterBuffers();
+        }
+        if (!ring->registerBuffers(buffers)) {
+            LOG_WARNING("io_uring buffer registration failed: " + std::string(std::strerror(errno)));
+            registeredBuffers.clear();
+            return false;
+        }
+    }
+#endif
+    registeredBuffers = buffers;
+    return true;
+}
+
+void AsyncIO::unregisterBuffers() {
+    std::lock_guard<std::mutex> lock(ioMutex);
+#ifdef ASYNCIO_HAS_IO_URING
+    if (ring && !registeredBuffers.empty()) {
+        ring->unregisterBuffers();
+    }
+#endif
+    registeredBuffers.clear();
+}
+
+bool AsyncIO::openFile(Operation& op) {
+#ifdef _WIN32
+    (void)op;
+    return true;  // The blocking backend opens files itself
+#else
+    int flags = O_CLOEXEC;
+    if (op.request.operation == IOOperation::Read) {
+        flags |= O_RDONLY;
+    } else {
+        flags |= O_WRONLY | O_CREAT;
+        if (op.request.truncate) flags |= O_TRUNC;
+    }
+    op.fd = ::open(op.request.path.c_str(), flags, 0644);
+    if (op.fd < 0) {
+        op.error = errno;
+        return false;
+    }
+    return true;
+#endif
+}
+
+size_t AsyncIO::submit(const std::vector<IORequest>& batch, CompletionCallback callback) {
+    PROFILE_SCOPE_CATEGORY("AsyncIO::submit", "io");
+    AllocationScope allocations(AllocationTag::IO);
+    auto sharedCallback = std::make_shared<CompletionCallback>(std::move(callback));
+    std::vector<Operation*> blocking;
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        for (const IORequest& request : batch) {
+            auto* op = new Operation();
+            op->request = request;
+            op->callback = sharedCallback;
+            if (request.registeredBuffer >= static_cast<int>(registeredBuffers.size())) {
+                op->request.registeredBuffer = -1;
+            }
+            inFlight++;
+            if (!openFile(*op)) {
+                finished.push_back(op);
+            } else if (ring) {
+                queued.push_back(op);
+            } else {
+                blocking.push_back(op);
+            }
+        }
+        if (ring) {
+            flushQueued();
+        }
+    }
+    for (Operation* op : blocking) {
+        ThreadPool::getIOPool().enqueue([this, op] { runBlocking(op); });
+    }
+    return batch.size();
+}
+
+int AsyncIO::flushQueued() {
+#ifdef ASYNCIO_HAS_IO_URING
+    while (!queued.empty() && ring->push(queued.front())) {
+        queued.pop_front();
+    }
+    int error = ring->enter(0);
+    if (error != 0 && !isTransientSubmitError(error)) {
+        failUnsubmitted(error);
+        return 0;
+    }
+    return error;
+#else
+    return 0;
+#endif
+}
+
+void AsyncIO::failUnsubmitted(int error) {
+#ifdef ASYNCIO_HAS_IO_URING
+    LOG_ERROR("io_uring submission failed: " + std::string(std::strerror(error)));
+    auto fail = [this, error](Operation* op) {
+        op->error = error;
+        finished.push_back(op);
+    };
+    ring->dropUnsubmitted(fail);
+    for (Operation* op : queued) {
+        fail(op);
+    }
+    queued.clear();
+#else
+    (void)error;
+#endif
+}
+
+void AsyncIO::runBlocking(Operation* op) {
+    IORequest& request = op->request;
+#ifdef _WIN32
+    if (request.operation == IOOperation::Read) {
+        std::ifstream file(request.path, std::ios::binary);
+        if (!file) {
+            op->error = ENOENT;
+        } else {
+            file.seekg(static_cast<std::streamoff>(request.offset));
+            file.read(reinterpret_cast<char*>(request.buffer), static_cast<std::streamsize>(request.length));
+            op->transferred = static_cast<size_t>(file.gcount());
+        }
+    } else {
+        std::ios::openmode mode = std::ios::binary | std::ios::out;
+        if (!request.truncate && FileSystem::getInstance().fileExists(request.path)) {
+            mode |= std::ios::in;
+        }
+        std::fstream file(request.path, mode);
+        if (!file) {
+            op->error = EACCES;
+        } else {
+            file.seekp(static_cast<std::streamoff>(request.offset));
+            file.write(reinterpret_cast<const char*>(request.buffer), static_cast<std::streamsize>(request.length));
+            op->transferred = file ? request.length : 0;
+            op->error = file ? 0 : EIO;
+        }
+    }
+#else
+    while (op->transferred < request.length) {
+        uint8_t* address = request.buffer + op->transferred;
+        size_t remaining = request.length - op->transferred;
+        off_t position = static_cast<off_t>(request.offset + op->transferred);
+        ssize_t result = request.operation == IOOperation::Read
+            ? pread(op->fd, address, remaining, position)
+            : pwrite(op->fd, address, remaining, position);
+        if (result < 0) {
+            if (errno == EINTR) continue;
+            op->error = errno;
+            break;
+        }
+        if (result == 0) {
+            break;  // End of file
+        }
+        op->transferred += static_cast<size_t>(result);
+    }
+#endif
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        finished.push_back(op);
+    }
+    finishedCondition.notify_all();
+}
+
+size_t AsyncIO::poll() {
+    return deliver(0, false);
+}
+
+size_t AsyncIO::wait(size_t minCompletions) {
+    return deliver(minCompletions, true);
+}
+
+void AsyncIO::waitAll() {
+    while (pending() > 0) {
+        deliver(1, true);
+    }
+}
+
+size_t AsyncIO::pending() const {
+    return inFlight.load();
+}
+
+size_t AsyncIO::deliver(size_t minCompletions, bool block) {
+    std::vector<Operation*> done;
+    {
+        std::unique_lock<std::mutex> lock(ioMutex);
+        int submitError = 0;
+        unsigned submitRetries = 0;
+        while (true) {
+#ifdef ASYNCIO_HAS_IO_URING
+            if (ring && !ringWaiting) {
+                ring->reap([this](Operation* op, int result) {
+                    if (result < 0) {
+                        op->error = -result;
+                    } else {
+                        op->transferred += static_cast<size_t>(result);
+                    }
+                    // Short transfers go back to the front of the queue for the rest
+                    bool complete = result <= 0 || op->transferred >= op->request.length;
+                    if (complete) {
+                        finished.push_back(op);
+                    } else {
+                        queued.push_front(op);
+                    }
+                });
+                submitError = flushQueued();
+            }
+#endif
+            while (!finished.empty()) {
+                done.push_back(finished.front());
+                finished.pop_front();
+            }
+            size_t outstanding = inFlight.load() - done.size();
+            if (!block || done.size() >= minCompletions || outstanding == 0) {
+                break;
+            }
+#ifdef ASYNCIO_HAS_IO_URING
+            if (ring && !ringWaiting && ring->hasUnsubmitted()) {
+                // waitForCompletion() submits nothing, so SQEs the kernel
+                // turned away must go in from here or fail, never sit unseen
+                if (++submitRetries < MAX_SUBMIT_RETRIES) {
+                    lock.unlock();
+                    std::this_thread::yield();
+                    lock.lock();
+                } else {
+                    failUnsubmitted(submitError != 0 ? submitError : EAGAIN);
+                }
+                continue;
+            }
+            if (ring && !ringWaiting) {
+                // Submission, reaping and callbacks from other threads go on
+                // while this one sleeps; the loop reaps once the lock is back
+                ringWaiting = true;
+                lock.unlock();
+                ring->waitForCompletion();
+                lock.lock();
+                ringWaiting = false;
+                finishedCondition.notify_all();
+                continue;
+            }
+#endif
+            finishedCondition.wait(lock, [this] { return !finished.empty() || (ring && !ringWaiting); });
+        }
+        inFlight -= done.size();
+    }
+
+    // Every operation is closed, freed and delivered even if a callback
+    // throws; the first exception is rethrown once all of them are done
+    std::exception_ptr error;
+    for (Operation* raw : done) {
+        std::unique_ptr<Operation> op(raw);
+        op->closeFile();
+        IOCompletion completion{op->request.userData, op->request.operation, op->transferred, op->error};
+        try {
+            if (*op->callback) {
+                (*op->callback)(completion);
+            }
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return done.size();
+}
+
+void AsyncIO::readFiles(const std::vector<std::string>& paths, FileCallback callback) {
+    struct FileRead {
+        std::string path;
+        std::vector<uint8_t> data;
+    };
+    auto reads = std::make_shared<std::vector<FileRead>>(paths.size());
+    std::vector<IORequest> batch;
+    batch.reserve(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        FileRead& read = (*reads)[i];
+        read.path = paths[i];
+        std::error_code error;
+        auto fileSize = fs::file_size(read.path, error);
+        if (!error) {
+            read.data.resize(static_cast<size_t>(fileSize));
+        }
+        IORequest request;
+        request.operation = IOOperation::Read;
+        request.path = read.path;
+        request.buffer = read.data.data();
+        request.length = read.data.size();
+        request.userData = i;
+        batch.push_back(std::move(request));
+    }
+    submit(batch, [reads, callback](const IOCompletion& completion) {
+        FileRead& read = (*reads)[completion.userData];
+        read.data.resize(completion.bytesTransferred);
+        callback(read.path, std::move(read.data), completion.error == 0);
+    });
+}
+
+void AsyncIO::writeFile(const std::string& path, std::shared_ptr<const std::vector<uint8_t>> data,
+                        std::function<void(bool success)> callback) {
+    IORequest request;
+    request.operation = IOOperation::Write;
+    request.path = path;
+    request.buffer = const_cast<uint8_t*>(data->data());
+    request.length = data->size();
+    request.truncate = true;
+    // The completion lambda keeps the data alive until the write finishes
+    submit({request}, [data, callback](const IOCompletion& completion) {
+        if (callback) {
+            callback(completion.error == 0 && completion.bytesTransferred == data->size());
+        }
+    });
+}
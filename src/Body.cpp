@@ -1,4 +1,4 @@
 #include "Body.h"
 
 Body::Body(double mass, const Vector& pos, const Vector& vel)
-    : mass(mass), position(pos), velocity(vel), acceleration() {} 
\ No newline at end of file
+    : mass(mass), position(pos), velocity(vel), acceleration(), radius(1.0f), color(1.0, 1.0, 1.0) {} 
\ No newline at end of file
@@ -0,0 +1,236 @@
+#include "DerivedAssetCache.h"
+#include "EngineConfig.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+constexpr uint32_t ENTRY_MAGIC = 0x43564544;  // "DEVC"
+constexpr uint32_t ENTRY_VERSION = 1;
+constexpr uint64_t PRIME_A = 0x9E3779B185EBCA87ull;
+constexpr uint64_t PRIME_B = 0xC2B2AE3D27D4EB4Full;
+
+uint64_t rotl(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+// Word-at-a-time mixing; two lanes with different constants give a 128-bit key
+void mix(uint64_t lanes[2], const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    while (size >= 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes, 8);
+        lanes[0] = rotl(lanes[0] ^ (word * PRIME_B), 31) * PRIME_A;
+        lanes[1] = rotl(lanes[1] ^ (word * PRIME_A), 27) * PRIME_B + 0x52DCE729;
+        bytes += 8;
+        size -= 8;
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, bytes, size);
+    tail ^= uint64_t(size) << 56;
+    lanes[0] = rotl(lanes[0] ^ (tail * PRIME_B), 31) * PRIME_A;
+    lanes[1] = rotl(lanes[1] ^ (tail * PRIME_A), 27) * PRIME_B + 0x52DCE729;
+}
+
+uint64_t finalize(uint64_t value) {
+    value ^= value >> 33;
+    value *= PRIME_B;
+    value ^= value >> 29;
+    value *= PRIME_A;
+    value ^= value >> 32;
+    return value;
+}
+}
+
+// KeyBuilder Implementation
+DerivedAssetCache::KeyBuilder::KeyBuilder(std::string_view kind)
+    : lanes{0x243F6A8885A308D3ull, 0x13198A2E03707344ull} {
+    add(kind);
+}
+
+DerivedAssetCache::KeyBuilder& DerivedAssetCache::KeyBuilder::add(const void* data, size_t size) {
+    mix(lanes, data, size);
+    return *this;
+}
+
+DerivedAssetCache::KeyBuilder& DerivedAssetCache::KeyBuilder::add(std::string_view text) {
+    // Length first, so ("ab", "c") and ("a", "bc") hash differently
+    uint64_t length = text.size();
+    mix(lanes, &length, sizeof(length));
+    mix(lanes, text.data(), text.size());
+    return *this;
+}
+
+std::string DerivedAssetCache::KeyBuilder::finish() const {
+    std::stringstream ss;
+    ss << std::hex << std::setfill('0')
+       << std::setw(16) << finalize(lanes[0] ^ rotl(lanes[1], 17))
+       << std::setw(16) << finalize(lanes[1] ^ rotl(lanes[0], 41));
+    return ss.str();
+}
+
+// DerivedAssetCache Implementation
+DerivedAssetCache& DerivedAssetCache::getInstance() {
+    static DerivedAssetCache instance;
+    return instance;
+}
+
+DerivedAssetCache::DerivedAssetCache()
+    : directory(EngineConfig::getInstance().getDerivedCacheDirectory()),
+      maxSize(EngineConfig::getInstance().getDerivedCacheMaxSize() * 1024 * 1024) {}
+
+DerivedAssetCache::~DerivedAssetCache() {}
+
+void DerivedAssetCache::setDirectory(const std::string& path) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    directory = path;
+}
+
+void DerivedAssetCache::setMaxSize(size_t bytes) {
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        maxSize = bytes;
+    }
+    enforceSizeCap();
+}
+
+uint64_t DerivedAssetCache::checksum(const void* data, size_t size) {
+    uint64_t lanes[2] = {0x452821E638D01377ull, 0xBE5466CF34E90C6Cull};
+    mix(lanes, data, size);
+    return finalize(lanes[0] ^ lanes[1]);
+}
+
+std::string DerivedAssetCache::entryPath(const std::string& key) const {
+    return (fs::path(directory) / (key + ".bin")).string();
+}
+
+bool DerivedAssetCache::load(const std::string& key, MappedFile& file, std::string_view& payload) {
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        path = entryPath(key);
+    }
+    if (!fs::exists(path) || !file.open(path, AccessHint::Sequential)) {
+        return false;
+    }
+
+    EntryHeader header;
+    bool valid = file.size() >= sizeof(header);
+    if (valid) {
+        std::memcpy(&header, file.data(), sizeof(header));
+        valid = header.magic == ENTRY_MAGIC && header.version == ENTRY_VERSION &&
+                header.payloadSize == file.size() - sizeof(header) &&
+                header.payloadChecksum == checksum(file.data() + sizeof(header), header.payloadSize);
+    }
+    if (!valid) {
+        LOG_WARNING("Discarding corrupt derived asset: " + path);
+        file.close();
+        invalidate(key);
+        return false;
+    }
+
+    payload = file.view(sizeof(header), header.payloadSize);
+    // The size cap evicts by modification time, so a hit refreshes it
+    std::error_code error;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), error);
+    return true;
+}
+
+bool DerivedAssetCache::store(const std::string& key, const void* data, size_t size) {
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        path = entryPath(key);
+        std::error_code error;
+        fs::create_directories(directory, error);
+    }
+
+    EntryHeader header{ENTRY_MAGIC, ENTRY_VERSION, size, checksum(data, size)};
+    std::stringstream tempName;
+    tempName << path << ".tmp" << std::this_thread::get_id();
+    {
+        std::ofstream file(tempName.str(), std::ios::binary | std::ios::trunc);
+        if (!file) {
+            LOG_WARNING("Failed to write derived asset: " + tempName.str());
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        if (!file) {
+            LOG_WARNING("Failed to write derived asset: " + tempName.str());
+            return false;
+        }
+    }
+
+    // Rename into place so readers never see a partially written entry
+    std::error_code error;
+    fs::rename(tempName.str(), path, error);
+    if (error) {
+        fs::remove(tempName.str(), error);
+        return false;
+    }
+    enforceSizeCap();
+    return true;
+}
+
+void DerivedAssetCache::invalidate(const std::string& key) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    std::error_code error;
+    fs::remove(entryPath(key), error);
+}
+
+void DerivedAssetCache::clear() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(directory, error)) {
+        if (entry.path().extension() == ".bin") {
+            fs::remove(entry.path(), error);
+        }
+    }
+}
+
+void DerivedAssetCache::enforceSizeCap() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    struct Entry {
+        fs::path path;
+        size_t size;
+        fs::file_time_type lastUse;
+    };
+    std::vector<Entry> entries;
+    size_t total = 0;
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(directory, error)) {
+        if (entry.is_regular_file(error) && entry.path().extension() == ".bin") {
+            Entry item{entry.path(), static_cast<size_t>(entry.file_size(error)), entry.last_write_time(error)};
+            total += item.size;
+            entries.push_back(std::move(item));
+        }
+    }
+    if (total <= maxSize) {
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.lastUse < b.lastUse; });
+    for (const Entry& entry : entries) {
+        if (total <= maxSize) {
+            break;
+        }
+        if (fs::remove(entry.path, error)) {
+            total -= entry.size;
+        }
+    }
+}
+
+size_t DerivedAssetCache::getTotalSize() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    size_t total = 0;
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(directory, error)) {
+        if (entry.is_regular_file(error) && entry.path().extension() == ".bin") {
+            total += static_cast<size_t>(entry.file_size(error));
+        }
+    }
+    return total;
+}
@@ -1,10 +1,28 @@
 #include "EngineBackend.h"
+#include "EngineConfig.h"
+#include "AsyncIO.h"
+#include "Profiler.h"
+#include "AllocationTracker.h"
+#include "FrameArena.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
 #include <future>
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#define NOGDI
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 // Logger Implementation
 Logger& Logger::getInstance() {
     static Logger instance;
@@ -22,7 +40,7 @@ Logger::~Logger() {
 }
 
 void Logger::setLogFile(const std::string& path) {
-    std::lock_guard<std::mutex> lock(logMutex);
+    std::lock_guard<InstrumentedMutex> lock(logMutex);
     if (logFile.is_open()) {
         logFile.close();
     }
@@ -55,7 +73,7 @@ std::string Logger::getLevelString(LogLevel level) {
 void Logger::log(LogLevel level, const std::string& message, const std::string& file, int line) {
     if (level < currentLevel) return;
 
-    std::lock_guard<std::mutex> lock(logMutex);
+    std::lock_guard<InstrumentedMutex> lock(logMutex);
     std::stringstream ss;
     ss << getTimestamp() << " [" << getLevelString(level) << "] ";
     if (!file.empty()) {
@@ -71,86 +89,149 @@ void Logger::log(LogLevel level, const std::string& message, const std::string&
 }
 
 void Logger::flush() {
-    std::lock_guard<std::mutex> lock(logMutex);
+    std::lock_guard<InstrumentedMutex> lock(logMutex);
     if (logFile.is_open()) {
         logFile.flush();
     }
 }
 
-// Cache Implementation
-template<typename T>
-Cache<T>::Cache(size_t maxSize, CachePolicy policy) 
-    : maxSize(maxSize), policy(policy) {}
+// MappedFile Implementation
+MappedFile::~MappedFile() {
+    close();
+}
 
-template<typename T>
-void Cache<T>::put(const std::string& key, const T& value) {
-    std::lock_guard<std::mutex> lock(cacheMutex);
-    if (cache.size() >= maxSize) {
-        evict();
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        mapping = std::exchange(other.mapping, nullptr);
+        length = std::exchange(other.length, 0);
+        opened = std::exchange(other.opened, false);
+#ifdef _WIN32
+        fileHandle = std::exchange(other.fileHandle, nullptr);
+        mappingHandle = std::exchange(other.mappingHandle, nullptr);
+#endif
     }
-    CacheEntry entry{value, std::chrono::system_clock::now(), 0};
-    cache[key] = entry;
+    return *this;
 }
 
-template<typename T>
-bool Cache<T>::get(const std::string& key, T& value) {
-    std::lock_guard<std::mutex> lock(cacheMutex);
-    auto it = cache.find(key);
-    if (it != cache.end()) {
-        it->second.lastAccess = std::chrono::system_clock::now();
-        it->second.accessCount++;
-        value = it->second.value;
-        return true;
+#ifdef _WIN32
+bool MappedFile::open(const std::string& path, AccessHint hint) {
+    close();
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+    if (hint == AccessHint::Sequential) flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    if (hint == AccessHint::Random) flags |= FILE_FLAG_RANDOM_ACCESS;
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, flags, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    length = static_cast<size_t>(fileSize.QuadPart);
+    opened = true;
+    if (length == 0) {
+        return true;  // Empty files can't be mapped but are still valid
     }
-    return false;
+
+    HANDLE mappingObject = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingObject) {
+        close();
+        return false;
+    }
+    mappingHandle = mappingObject;
+    mapping = static_cast<const uint8_t*>(MapViewOfFile(mappingObject, FILE_MAP_READ, 0, 0, 0));
+    if (!mapping) {
+        close();
+        return false;
+    }
+    return true;
 }
 
-template<typename T>
-void Cache<T>::remove(const std::string& key) {
-    std::lock_guard<std::mutex> lock(cacheMutex);
-    cache.erase(key);
+void MappedFile::close() {
+    if (mapping) UnmapViewOfFile(mapping);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+    mapping = nullptr;
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+    length = 0;
+    opened = false;
+}
+
+void MappedFile::advise(AccessHint, size_t, size_t) const {
+    // Windows only takes access hints when the file is opened
+}
+#else
+bool MappedFile::open(const std::string& path, AccessHint hint) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    length = static_cast<size_t>(info.st_size);
+    opened = true;
+    if (length > 0) {
+        void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            ::close(fd);
+            close();
+            return false;
+        }
+        mapping = static_cast<const uint8_t*>(address);
+    }
+    // The mapping keeps the file referenced; the descriptor isn't needed anymore
+    ::close(fd);
+    advise(hint);
+    return true;
 }
 
-template<typename T>
-void Cache<T>::clear() {
-    std::lock_guard<std::mutex> lock(cacheMutex);
-    cache.clear();
+void MappedFile::close() {
+    if (mapping) {
+        munmap(const_cast<uint8_t*>(mapping), length);
+    }
+    mapping = nullptr;
+    length = 0;
+    opened = false;
 }
 
-template<typename T>
-size_t Cache<T>::size() const {
-    std::lock_guard<std::mutex> lock(cacheMutex);
-    return cache.size();
+void MappedFile::advise(AccessHint hint, size_t offset, size_t count) const {
+    if (!mapping || offset >= length) {
+        return;
+    }
+    int advice = POSIX_MADV_NORMAL;
+    switch (hint) {
+        case AccessHint::Normal: advice = POSIX_MADV_NORMAL; break;
+        case AccessHint::Sequential: advice = POSIX_MADV_SEQUENTIAL; break;
+        case AccessHint::Random: advice = POSIX_MADV_RANDOM; break;
+        case AccessHint::WillNeed: advice = POSIX_MADV_WILLNEED; break;
+    }
+    // madvise ranges must start on a page boundary
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t alignedOffset = offset - offset % pageSize;
+    size_t end = (count == 0 || count > length - offset) ? length : offset + count;
+    posix_madvise(const_cast<uint8_t*>(mapping) + alignedOffset, end - alignedOffset, advice);
 }
+#endif
 
-template<typename T>
-void Cache<T>::evict() {
-    switch (policy) {
-        case CachePolicy::LRU: {
-            auto oldest = std::min_element(cache.begin(), cache.end(),
-                [](const auto& a, const auto& b) {
-                    return a.second.lastAccess < b.second.lastAccess;
-                });
-            if (oldest != cache.end()) {
-                cache.erase(oldest);
-            }
-            break;
-        }
-        case CachePolicy::LFU: {
-            auto leastFrequent = std::min_element(cache.begin(), cache.end(),
-                [](const auto& a, const auto& b) {
-                    return a.second.accessCount < b.second.accessCount;
-                });
-            if (leastFrequent != cache.end()) {
-                cache.erase(leastFrequent);
-            }
-            break;
-        }
-        case CachePolicy::FIFO: {
-            cache.erase(cache.begin());
-            break;
-        }
+std::string_view MappedFile::view(size_t offset, size_t count) const {
+    if (offset >= length) {
+        return {};
     }
+    return view().substr(offset, count);
 }
 
 // FileSystem Implementation
@@ -164,15 +245,19 @@ FileSystem::~FileSystem() {}
 
 bool FileSystem::loadFile(const std::string& path, std::vector<uint8_t>& data) {
     try {
-        std::ifstream file(path, std::ios::binary);
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
         if (!file) {
             LOG_ERROR("Failed to open file: " + path);
             return false;
         }
-        data = std::vector<uint8_t>(
-            std::istreambuf_iterator<char>(file),
-            std::istreambuf_iterator<char>()
-        );
+        // Size the buffer once and read in bulk rather than streaming byte by byte
+        std::streamsize fileSize = file.tellg();
+        file.seekg(0, std::ios::beg);
+        data.resize(static_cast<size_t>(fileSize));
+        if (fileSize > 0 && !file.read(reinterpret_cast<char*>(data.data()), fileSize)) {
+            LOG_ERROR("Failed to read file: " + path);
+            return false;
+        }
         return true;
     } catch (const std::exception& e) {
         LOG_ERROR("Error loading file " + path + ": " + e.what());
@@ -180,6 +265,14 @@ bool FileSystem::loadFile(const std::string& path, std::vector<uint8_t>& data) {
     }
 }
 
+bool FileSystem::mapFile(const std::string& path, MappedFile& file, AccessHint hint) {
+    if (!file.open(path, hint)) {
+        LOG_ERROR("Failed to map file: " + path);
+        return false;
+    }
+    return true;
+}
+
 bool FileSystem::saveFile(const std::string& path, const std::vector<uint8_t>& data) {
     try {
         std::ofstream file(path, std::ios::binary);
@@ -195,6 +288,53 @@ bool FileSystem::saveFile(const std::string& path, const std::vector<uint8_t>& d
     }
 }
 
+void FileSystem::loadFilesAsync(const std::vector<std::string>& paths,
+                                std::function<void(const std::string& path, std::vector<uint8_t>&& data, bool success)> callback) {
+    AsyncIO::getInstance().readFiles(paths, std::move(callback));
+}
+
+void FileSystem::saveFileAsync(const std::string& path, std::shared_ptr<const std::vector<uint8_t>> data,
+                               std::function<void(bool success)> callback) {
+    AsyncIO::getInstance().writeFile(path, std::move(data), std::move(callback));
+}
+
+bool FileSystem::loadFiles(const std::vector<std::string>& paths, std::vector<std::vector<uint8_t>>& data) {
+    data.assign(paths.size(), {});
+    if (paths.empty()) {
+        return true;
+    }
+    // Completions only carry the path; a path listed twice fills every slot
+    std::unordered_map<std::string, std::vector<size_t>> slots;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        slots[paths[i]].push_back(i);
+    }
+    std::atomic<size_t> remaining{slots.size()};
+    std::atomic<bool> success{true};
+    std::vector<std::string> unique;
+    unique.reserve(slots.size());
+    for (const auto& [path, indices] : slots) {
+        unique.push_back(path);
+    }
+    loadFilesAsync(unique, [&](const std::string& path, std::vector<uint8_t>&& bytes, bool ok) {
+        if (!ok) {
+            LOG_ERROR("Failed to read file: " + path);
+            success = false;
+        }
+        const std::vector<size_t>& indices = slots.at(path);
+        for (size_t i = 1; i < indices.size(); ++i) {
+            data[indices[i]] = bytes;
+        }
+        data[indices.front()] = std::move(bytes);
+        remaining.fetch_sub(1, std::memory_order_release);
+    });
+    // Another thread polling AsyncIO may deliver some of these; wait() then
+    // still returns as soon as anything completes
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        AsyncIO::getInstance().wait(1);
+    }
+    return success;
+}
+
 bool FileSystem::fileExists(const std::string& path) {
     return fs::exists(path);
 }
@@ -235,7 +375,7 @@ ThreadPool::ThreadPool(size_t numThreads) : stop(false) {
             while (true) {
                 std::function<void()> task;
                 {
-                    std::unique_lock<std::mutex> lock(queueMutex);
+                    std::unique_lock<InstrumentedMutex> lock(queueMutex);
                     condition.wait(lock, [this] {
                         return stop || !tasks.empty();
                     });
@@ -253,7 +393,7 @@ ThreadPool::ThreadPool(size_t numThreads) : stop(false) {
 
 ThreadPool::~ThreadPool() {
     {
-        std::unique_lock<std::mutex> lock(queueMutex);
+        std::unique_lock<InstrumentedMutex> lock(queueMutex);
         stop = true;
     }
     condition.notify_all();
@@ -262,52 +402,174 @@ ThreadPool::~ThreadPool() {
     }
 }
 
-template<class F, class... Args>
-void ThreadPool::enqueue(F&& f, Args&&... args) {
-    auto task = std::make_shared<std::packaged_task<void()>>(
-        std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-    );
-    {
-        std::unique_lock<std::mutex> lock(queueMutex);
-        if (stop) {
-            throw std::runtime_error("enqueue on stopped ThreadPool");
+ThreadPool& ThreadPool::getIOPool() {
+    static ThreadPool instance(static_cast<size_t>(std::max(1, EngineConfig::getInstance().getIOThreads())));
+    return instance;
+}
+
+ThreadPool& ThreadPool::getRenderPool() {
+    static ThreadPool instance(static_cast<size_t>(std::max(1, EngineConfig::getInstance().getRenderThreads())));
+    return instance;
+}
+
+void ThreadPool::parallelFor(size_t count, size_t minShare, const std::function<void(size_t, size_t)>& body) {
+    size_t shares = std::min(workers.size() + 1, count / std::max<size_t>(minShare, 1));
+    if (shares <= 1) {
+        if (count > 0) {
+            body(0, count);
+        }
+        return;
+    }
+
+    size_t shareSize = (count + shares - 1) / shares;
+    std::vector<std::future<void>> pending;
+    pending.reserve(shares - 1);
+    // Queued shares reference body and this frame, so every one must finish
+    // before anything propagates out of here, whichever share threw
+    std::exception_ptr error;
+    try {
+        for (size_t begin = shareSize; begin < count; begin += shareSize) {
+            size_t end = std::min(count, begin + shareSize);
+            std::packaged_task<void()> task([&body, begin, end] { body(begin, end); });
+            pending.push_back(task.get_future());
+            enqueue(std::move(task));
         }
-        tasks.emplace([task]() { (*task)(); });
+        body(0, shareSize);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    for (std::future<void>& share : pending) {
+        share.wait();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    for (std::future<void>& share : pending) {
+        share.get();  // Rethrows a worker's exception
     }
-    condition.notify_one();
 }
 
 void ThreadPool::waitForCompletion() {
-    std::unique_lock<std::mutex> lock(queueMutex);
+    std::unique_lock<InstrumentedMutex> lock(queueMutex);
     condition.wait(lock, [this] { return tasks.empty(); });
 }
 
 // EventSystem Implementation
-void EventSystem::subscribe(const std::string& eventName, EventCallback callback) {
-    std::lock_guard<std::mutex> lock(eventMutex);
-    eventHandlers[eventName].push_back(callback);
-}
-
-void EventSystem::unsubscribe(const std::string& eventName, EventCallback callback) {
-    std::lock_guard<std::mutex> lock(eventMutex);
-    auto& handlers = eventHandlers[eventName];
-    handlers.erase(
-        std::remove_if(handlers.begin(), handlers.end(),
-            [&callback](const EventCallback& h) {
-                return h.target_type() == callback.target_type();
-            }),
-        handlers.end()
-    );
-}
-
-void EventSystem::emit(const std::string& eventName, const void* data) {
-    std::lock_guard<std::mutex> lock(eventMutex);
-    auto it = eventHandlers.find(eventName);
-    if (it != eventHandlers.end()) {
-        for (const auto& handler : it->second) {
-            handler(data);
+EventSystem::EventSystem() {
+    for (auto& list : handlers) {
+        list.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+EventSystem::~EventSystem() {
+    for (auto& list : handlers) {
+        delete list.load(std::memory_order_relaxed);
+    }
+    for (const HandlerList* list : retired) {
+        delete list;
+    }
+}
+
+EventSystem& EventSystem::getEngineEvents() {
+    static EventSystem instance;
+    return instance;
+}
+
+uint32_t EventSystem::nextTypeId() {
+    static std::atomic<uint32_t> next{0};
+    uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+    if (id >= MAX_EVENT_TYPES) {
+        throw std::runtime_error("EventSystem supports at most " + std::to_string(MAX_EVENT_TYPES) + " event types");
+    }
+    return id;
+}
+
+EventSystem::Subscription EventSystem::addHandler(uint32_t type, std::function<void(const void*)> call) {
+    std::lock_guard<InstrumentedMutex> lock(subscriptionMutex);
+    Subscription token = (nextToken++ << TYPE_BITS) | type;
+    const HandlerList* current = handlers[type].load(std::memory_order_relaxed);
+    auto* next = current ? new HandlerList(*current) : new HandlerList();
+    next->push_back(Handler{token, std::move(call)});
+    replaceHandlers(type, next);
+    return token;
+}
+
+void EventSystem::unsubscribe(Subscription token) {
+    uint32_t type = static_cast<uint32_t>(token & (MAX_EVENT_TYPES - 1));
+    std::lock_guard<InstrumentedMutex> lock(subscriptionMutex);
+    const HandlerList* current = handlers[type].load(std::memory_order_relaxed);
+    if (!current) {
+        return;
+    }
+    auto* next = new HandlerList();
+    next->reserve(current->size());
+    for (const Handler& handler : *current) {
+        if (handler.token != token) {
+            next->push_back(handler);
+        }
+    }
+    replaceHandlers(type, next);
+}
+
+void EventSystem::replaceHandlers(uint32_t type, const HandlerList* next) {
+    // Pairs with deliver(): an emitter either counted itself before this
+    // exchange or loads the new list, so a zero count means nothing can
+    // still be reading a retired list
+    const HandlerList* previous = handlers[type].exchange(next, std::memory_order_seq_cst);
+    if (previous) {
+        retired.push_back(previous);
+    }
+    if (activeEmits.load(std::memory_order_seq_cst) == 0) {
+        for (const HandlerList* list : retired) {
+            delete list;
+        }
+        retired.clear();
+    }
+}
+
+void EventSystem::deliver(uint32_t type, const void* event) const {
+    struct EmitGuard {
+        std::atomic<uint32_t>& count;
+        explicit EmitGuard(std::atomic<uint32_t>& count) : count(count) {
+            count.fetch_add(1, std::memory_order_seq_cst);
+        }
+        ~EmitGuard() { count.fetch_sub(1, std::memory_order_release); }
+    } guard(activeEmits);
+
+    const HandlerList* list = handlers[type].load(std::memory_order_seq_cst);
+    if (list) {
+        for (const Handler& handler : *list) {
+            handler.call(event);
+        }
+    }
+}
+
+void EventSystem::dispatchDeferred() {
+    std::array<QueueBase*, MAX_EVENT_TYPES> ready;
+    size_t readyCount = 0;
+    {
+        std::lock_guard<InstrumentedMutex> lock(queueMutex);
+        for (const auto& queue : queues) {
+            if (queue && queue->hasPending()) {
+                queue->takePending();
+                ready[readyCount++] = queue.get();
+            }
+        }
+    }
+    // Queues are never freed, and only this thread touches their dispatching side
+    std::exception_ptr error;
+    for (size_t i = 0; i < readyCount; ++i) {
+        try {
+            ready[i]->dispatch(*this);
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
         }
     }
+    if (error) {
+        std::rethrow_exception(error);
+    }
 }
 
 // PerformanceMonitor Implementation
@@ -316,18 +578,94 @@ PerformanceMonitor& PerformanceMonitor::getInstance() {
     return instance;
 }
 
+namespace {
+std::chrono::nanoseconds sampleIntervalFromConfig() {
+    double seconds = std::max(EngineConfig::getInstance().getProfilingInterval(), 0.001);
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(seconds));
+}
+
+size_t windowSlotsFromConfig() {
+    double interval = std::max(EngineConfig::getInstance().getProfilingInterval(), 0.001);
+    double window = EngineConfig::getInstance().getHistogramWindow();
+    return std::max<size_t>(1, static_cast<size_t>(std::lround(window / interval)));
+}
+
+// Name and report scale (recorded value to report units) of each
+// PerformanceMonitor::Metric, in enum order
+struct MetricInfo {
+    const char* name;
+    double scale;
+};
+constexpr MetricInfo METRIC_INFO[] = {
+    {"frame_time", 1e-6},  // Nanoseconds to milliseconds
+    {"fps", 1e-3},
+    {"memory_usage", 1.0 / (1024.0 * 1024.0)},
+    {"allocations", 1.0},
+    {"frame_arena", 1.0 / 1024.0},
+    {"draw_calls", 1.0},
+    {"triangles", 1.0},
+    {"vertices", 1.0},
+    {"visible_objects", 1.0},
+    {"culled_objects", 1.0},
+    {"occluded_objects", 1.0},
+};
+}
+
+size_t PerformanceMonitor::findMetric(const std::string& name) {
+    static_assert(sizeof(METRIC_INFO) / sizeof(METRIC_INFO[0]) == METRIC_COUNT, "One METRIC_INFO entry per Metric");
+    for (size_t i = 0; i < METRIC_COUNT; ++i) {
+        if (name == METRIC_INFO[i].name) {
+            return i;
+        }
+    }
+    return METRIC_COUNT;
+}
+
 PerformanceMonitor::PerformanceMonitor() 
-    : fps(0.0), frameCount(0), lastFPSUpdate(std::chrono::system_clock::now()) {}
+    : sampleInterval(sampleIntervalFromConfig()),
+      windowSlots(windowSlotsFromConfig()),
+      reportedMetrics(EngineConfig::getInstance().getProfilingMetrics()),
+      framesSinceSample(0),
+      fps(0.0), frameCount(0), lastFPSUpdate(std::chrono::steady_clock::now()) {
+    lastSample = lastFPSUpdate;
+    for (auto& histogram : metrics) {
+        histogram = std::make_unique<Histogram>(windowSlots);
+    }
+    // Configured operations show up in reports before their first run
+    for (const auto& metric : reportedMetrics) {
+        if (findMetric(metric) == METRIC_COUNT) {
+            auto operation = std::make_unique<Operation>(windowSlots);
+            operation->zone = Profiler::getInstance().internZone(metric, "operation");
+            operations.emplace(metric, std::move(operation));
+        }
+    }
+}
 
 PerformanceMonitor::~PerformanceMonitor() {}
 
 void PerformanceMonitor::startFrame() {
-    frameStart = std::chrono::system_clock::now();
+    frameStart = std::chrono::steady_clock::now();
 }
 
 void PerformanceMonitor::endFrame() {
     frameCount++;
-    auto now = std::chrono::system_clock::now();
+    framesSinceSample++;
+    auto now = std::chrono::steady_clock::now();
+    // Frame time is end-to-end, so time spent outside startFrame/endFrame counts too
+    if (lastFrameEnd.time_since_epoch().count() != 0) {
+        metrics[FRAME_TIME]->record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastFrameEnd).count()));
+    }
+    lastFrameEnd = now;
+    AllocationTracker& allocations = AllocationTracker::getInstance();
+    allocations.endFrame();
+    metrics[ALLOCATIONS]->record(allocations.getLastFrameTotalStats().allocations);
+    FrameArena& frameArena = FrameArena::getInstance();
+    frameArena.endFrame();
+    metrics[FRAME_ARENA]->record(frameArena.getLastFrameUsage());
+    for (size_t metric = FIRST_RENDER_METRIC; metric < METRIC_COUNT; ++metric) {
+        metrics[metric]->record(pending[metric].exchange(0, std::memory_order_relaxed));
+    }
     auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastFPSUpdate).count();
     
     if (elapsed >= 1000) {
@@ -335,23 +673,78 @@ void PerformanceMonitor::endFrame() {
         frameCount = 0;
         lastFPSUpdate = now;
     }
+    if (now - lastSample >= sampleInterval) {
+        sample(now);
+    }
+    // Keep the per-thread profiler rings from filling up
+    Profiler::getInstance().collect();
+}
+
+void PerformanceMonitor::sample(std::chrono::steady_clock::time_point now) {
+    double seconds = std::chrono::duration<double>(now - lastSample).count();
+    metrics[FPS]->record(static_cast<uint64_t>(framesSinceSample / seconds * 1000.0));
+    metrics[MEMORY_USAGE]->record(getMemoryUsage());
+    framesSinceSample = 0;
+    lastSample = now;
+
+    // One window slot per sample interval
+    for (auto& histogram : metrics) {
+        histogram->advance();
+    }
+    std::lock_guard<InstrumentedMutex> lock(monitorMutex);
+    for (auto& [name, operation] : operations) {
+        operation->durations.advance();
+    }
+}
+
+PerformanceMonitor::Operation& PerformanceMonitor::lookupOperation(const std::string& name) {
+    // After a thread's first use of a name, lookups take no lock
+    static thread_local std::unordered_map<std::string, Operation*> threadOperations;
+    auto it = threadOperations.find(name);
+    if (it != threadOperations.end()) {
+        return *it->second;
+    }
+
+    std::lock_guard<InstrumentedMutex> lock(monitorMutex);
+    auto& operation = operations[name];
+    if (!operation) {
+        operation = std::make_unique<Operation>(windowSlots);
+        operation->zone = Profiler::getInstance().internZone(name, "operation");
+    }
+    threadOperations.emplace(name, operation.get());
+    return *operation;
+}
+
+std::vector<PerformanceMonitor::OpenOperation>& PerformanceMonitor::openOperations() {
+    static thread_local std::vector<OpenOperation> stack;
+    return stack;
 }
 
 void PerformanceMonitor::startOperation(const std::string& name) {
-    std::lock_guard<std::mutex> lock(monitorMutex);
-    operationTimes[name] = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::system_clock::now().time_since_epoch()
-    ).count();
+    Operation& operation = lookupOperation(name);
+    uint32_t depth = ProfileScope::currentDepth()++;
+    openOperations().push_back({&operation, Profiler::now(), depth});
 }
 
 void PerformanceMonitor::endOperation(const std::string& name) {
-    std::lock_guard<std::mutex> lock(monitorMutex);
-    auto end = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::system_clock::now().time_since_epoch()
-    ).count();
-    auto it = operationTimes.find(name);
-    if (it != operationTimes.end()) {
-        it->second = end - it->second;
+    uint64_t end = Profiler::now();
+    Operation& operation = lookupOperation(name);
+    auto& stack = openOperations();
+    // Normally the top entry; searching handles operations ended out of order
+    auto it = std::find_if(stack.rbegin(), stack.rend(),
+                           [&](const OpenOperation& open) { return open.operation == &operation; });
+    if (it == stack.rend()) {
+        return;
+    }
+    OpenOperation open = *it;
+    stack.erase(std::next(it).base());
+    ProfileScope::currentDepth()--;
+
+    operation.lastDuration.store(end - open.start, std::memory_order_relaxed);
+    operation.durations.record(end - open.start);
+    Profiler& profiler = Profiler::getInstance();
+    if (profiler.isEnabled()) {
+        profiler.record(operation.zone, open.start, end, open.depth);
     }
 }
 
@@ -360,18 +753,118 @@ double PerformanceMonitor::getFPS() const {
 }
 
 double PerformanceMonitor::getOperationTime(const std::string& name) const {
-    std::lock_guard<std::mutex> lock(monitorMutex);
-    auto it = operationTimes.find(name);
-    return it != operationTimes.end() ? it->second / 1000.0 : 0.0;
+    std::lock_guard<InstrumentedMutex> lock(monitorMutex);
+    auto it = operations.find(name);
+    return it != operations.end() ? it->second->lastDuration.load(std::memory_order_relaxed) / 1e6 : 0.0;
+}
+
+void PerformanceMonitor::addRenderStats(const RenderStats& stats) {
+    pending[DRAW_CALLS].fetch_add(stats.drawCalls, std::memory_order_relaxed);
+    pending[TRIANGLES].fetch_add(stats.triangles, std::memory_order_relaxed);
+    pending[VERTICES].fetch_add(stats.vertices, std::memory_order_relaxed);
+    pending[VISIBLE_OBJECTS].fetch_add(stats.visibleObjects, std::memory_order_relaxed);
+    pending[CULLED_OBJECTS].fetch_add(stats.culledObjects, std::memory_order_relaxed);
+    pending[OCCLUDED_OBJECTS].fetch_add(stats.occludedObjects, std::memory_order_relaxed);
+    totalTriangles.fetch_add(stats.triangles, std::memory_order_relaxed);
+    totalVertices.fetch_add(stats.vertices, std::memory_order_relaxed);
+    totalFullDetailTriangles.fetch_add(stats.fullDetailTriangles, std::memory_order_relaxed);
+    totalFullDetailVertices.fetch_add(stats.fullDetailVertices, std::memory_order_relaxed);
 }
 
 void PerformanceMonitor::reset() {
-    std::lock_guard<std::mutex> lock(monitorMutex);
-    operationTimes.clear();
+    std::lock_guard<InstrumentedMutex> lock(monitorMutex);
+    for (auto& [name, operation] : operations) {
+        operation->lastDuration.store(0, std::memory_order_relaxed);
+        operation->durations.reset();
+    }
+    for (size_t metric = 0; metric < METRIC_COUNT; ++metric) {
+        metrics[metric]->reset();
+        pending[metric].store(0, std::memory_order_relaxed);
+    }
+    totalTriangles.store(0, std::memory_order_relaxed);
+    totalVertices.store(0, std::memory_order_relaxed);
+    totalFullDetailTriangles.store(0, std::memory_order_relaxed);
+    totalFullDetailVertices.store(0, std::memory_order_relaxed);
     frameCount = 0;
+    framesSinceSample = 0;
     fps = 0.0;
 }
 
+PerformanceMonitor::MetricSummary PerformanceMonitor::getMetricSummary(const std::string& metric) const {
+    const Histogram* histogram = nullptr;
+    double scale = 1e-6;  // Operations record nanoseconds; report milliseconds
+    size_t index = findMetric(metric);
+    if (index != METRIC_COUNT) {
+        histogram = metrics[index].get();
+        scale = METRIC_INFO[index].scale;
+    } else {
+        // Operations are never erased, so the histogram can be read after unlocking
+        std::lock_guard<InstrumentedMutex> lock(monitorMutex);
+        auto it = operations.find(metric);
+        if (it == operations.end()) {
+            return MetricSummary();
+        }
+        histogram = &it->second->durations;
+    }
+
+    Histogram::Summary summary = histogram->summarize();
+    MetricSummary result;
+    result.count = summary.count;
+    result.p50 = summary.p50 * scale;
+    result.p90 = summary.p90 * scale;
+    result.p99 = summary.p99 * scale;
+    result.max = summary.max * scale;
+    return result;
+}
+
+std::string PerformanceMonitor::getReport() const {
+    std::vector<std::string> metrics = {"frame_time"};
+    for (const auto& metric : reportedMetrics) {
+        if (metric != "frame_time") {
+            metrics.push_back(metric);
+        }
+    }
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    for (const auto& metric : metrics) {
+        MetricSummary summary = getMetricSummary(metric);
+        ss << metric << ": n=" << summary.count << " p50=" << summary.p50 << " p90=" << summary.p90
+           << " p99=" << summary.p99 << " max=" << summary.max << "\n";
+    }
+    uint64_t fullTriangles = totalFullDetailTriangles.load(std::memory_order_relaxed);
+    uint64_t fullVertices = totalFullDetailVertices.load(std::memory_order_relaxed);
+    if (fullTriangles > 0 && fullVertices > 0) {
+        double triangles = totalTriangles.load(std::memory_order_relaxed);
+        double vertices = totalVertices.load(std::memory_order_relaxed);
+        ss << "lod: triangles saved " << 100.0 * (1.0 - triangles / fullTriangles) << "% vertices saved "
+           << 100.0 * (1.0 - vertices / fullVertices) << "%\n";
+    }
+    ss << FrameArena::getInstance().getReport();
+    ss << LockRegistry::getInstance().getReport();
+    return ss.str();
+}
+
+size_t PerformanceMonitor::getMemoryUsage() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.WorkingSetSize;
+    }
+    return 0;
+#elif defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0;
+    size_t resident = 0;
+    if (statm >> pages >> resident) {
+        return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+    return 0;
+#else
+    return 0;
+#endif
+}
+
 // ErrorHandler Implementation
 ErrorHandler& ErrorHandler::getInstance() {
     static ErrorHandler instance;
@@ -383,7 +876,7 @@ ErrorHandler::ErrorHandler() : errorOccurred(false) {}
 ErrorHandler::~ErrorHandler() {}
 
 void ErrorHandler::handleError(const std::string& error, bool fatal) {
-    std::lock_guard<std::mutex> lock(errorMutex);
+    std::lock_guard<InstrumentedMutex> lock(errorMutex);
     lastError = error;
     errorOccurred = true;
     if (errorCallback) {
@@ -398,22 +891,22 @@ void ErrorHandler::handleError(const std::string& error, bool fatal) {
 }
 
 void ErrorHandler::setErrorCallback(std::function<void(const std::string&, bool)> callback) {
-    std::lock_guard<std::mutex> lock(errorMutex);
+    std::lock_guard<InstrumentedMutex> lock(errorMutex);
     errorCallback = callback;
 }
 
 bool ErrorHandler::hasError() const {
-    std::lock_guard<std::mutex> lock(errorMutex);
+    std::lock_guard<InstrumentedMutex> lock(errorMutex);
     return errorOccurred;
 }
 
 std::string ErrorHandler::getLastError() const {
-    std::lock_guard<std::mutex> lock(errorMutex);
+    std::lock_guard<InstrumentedMutex> lock(errorMutex);
     return lastError;
 }
 
 void ErrorHandler::clearError() {
-    std::lock_guard<std::mutex> lock(errorMutex);
+    std::lock_guard<InstrumentedMutex> lock(errorMutex);
     errorOccurred = false;
     lastError.clear();
 }
@@ -429,18 +922,23 @@ ConfigManager::~ConfigManager() {}
 
 bool ConfigManager::loadConfig(const std::string& path) {
     try {
-        std::ifstream file(path);
-        if (!file) {
+        MappedFile file;
+        if (!file.open(path, AccessHint::Sequential)) {
             LOG_ERROR("Failed to open config file: " + path);
             return false;
         }
-        std::string line;
-        while (std::getline(file, line)) {
+        std::string_view text = file.view();
+        while (!text.empty()) {
+            size_t end = text.find('\n');
+            std::string_view line = text.substr(0, end);
+            text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
             size_t pos = line.find('=');
-            if (pos != std::string::npos) {
-                std::string key = line.substr(0, pos);
-                std::string value = line.substr(pos + 1);
-                config[key] = value;
+            if (pos != std::string_view::npos) {
+                std::lock_guard<InstrumentedMutex> lock(configMutex);
+                config[std::string(line.substr(0, pos))] = std::string(line.substr(pos + 1));
             }
         }
         return true;
@@ -468,22 +966,22 @@ bool ConfigManager::saveConfig(const std::string& path) {
 }
 
 void ConfigManager::setValue(const std::string& key, const std::string& value) {
-    std::lock_guard<std::mutex> lock(configMutex);
+    std::lock_guard<InstrumentedMutex> lock(configMutex);
     config[key] = value;
 }
 
 std::string ConfigManager::getValue(const std::string& key, const std::string& defaultValue) const {
-    std::lock_guard<std::mutex> lock(configMutex);
+    std::lock_guard<InstrumentedMutex> lock(configMutex);
     auto it = config.find(key);
     return it != config.end() ? it->second : defaultValue;
 }
 
 bool ConfigManager::hasKey(const std::string& key) const {
-    std::lock_guard<std::mutex> lock(configMutex);
+    std::lock_guard<InstrumentedMutex> lock(configMutex);
     return config.find(key) != config.end();
 }
 
 void ConfigManager::clear() {
-    std::lock_guard<std::mutex> lock(configMutex);
+    std::lock_guard<InstrumentedMutex> lock(configMutex);
     config.clear();
 } 
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "EngineConfig.h"
 #include <fstream>
 #include <sstream>
+#include <algorithm>
 
 EngineConfig& EngineConfig::getInstance() {
     static EngineConfig instance;
@@ -8,37 +9,62 @@ EngineConfig& EngineConfig::getInstance() {
 }
 
 EngineConfig::EngineConfig() {
+    publish(std::make_unique<const EngineSettings>());
     loadConfig();
+    if (getSettings().debug.configHotReload) {
+        watcher = std::thread(&EngineConfig::watchConfig, this);
+    }
 }
 
-EngineConfig::~EngineConfig() {}
+EngineConfig::~EngineConfig() {
+    {
+        std::lock_guard<std::mutex> lock(watcherMutex);
+        stopWatcher = true;
+    }
+    watcherCondition.notify_all();
+    if (watcher.joinable()) {
+        watcher.join();
+    }
+}
 
 bool EngineConfig::loadConfig(const std::string& path) {
-    std::lock_guard<std::mutex> lock(configMutex);
-    try {
-        std::ifstream file(path);
-        if (!file.is_open()) {
-            LOG_ERROR("Failed to open config file: " + path);
-            return false;
-        }
-        file >> config;
-        configPath = path;
-        
-        if (!validateConfig()) {
-            LOG_ERROR("Invalid configuration file");
+    ConfigChangedEvent event{nullptr, nullptr};
+    {
+        std::lock_guard<InstrumentedMutex> lock(configMutex);
+        try {
+            MappedFile file;
+            if (!file.open(path, AccessHint::Sequential)) {
+                LOG_ERROR("Failed to open config file: " + path);
+                return false;
+            }
+            std::string_view text = file.view();
+            json parsed = json::parse(text.begin(), text.end());
+
+            if (!validateConfig(parsed)) {
+                LOG_ERROR("Invalid configuration file");
+                return false;
+            }
+
+            auto settings = std::make_unique<const EngineSettings>(EngineSettings::fromJson(parsed));
+            config = std::move(parsed);
+            configPath = path;
+            std::error_code error;
+            configWriteTime = std::filesystem::last_write_time(path, error);
+            event.current = settings.get();
+            event.previous = publish(std::move(settings));
+        } catch (const std::exception& e) {
+            LOG_ERROR("Error loading config: " + std::string(e.what()));
             return false;
         }
-        
-        LOG_INFO("Configuration loaded successfully from: " + path);
-        return true;
-    } catch (const std::exception& e) {
-        LOG_ERROR("Error loading config: " + std::string(e.what()));
-        return false;
     }
+
+    LOG_INFO("Configuration loaded successfully from: " + path);
+    EventSystem::getEngineEvents().post(event);
+    return true;
 }
 
 bool EngineConfig::saveConfig(const std::string& path) {
-    std::lock_guard<std::mutex> lock(configMutex);
+    std::lock_guard<InstrumentedMutex> lock(configMutex);
     try {
         std::ofstream file(path);
         if (!file.is_open()) {
@@ -55,18 +81,42 @@ bool EngineConfig::saveConfig(const std::string& path) {
     }
 }
 
-template<typename T>
-T EngineConfig::getValue(const std::string& path, const T& defaultValue) const {
-    std::lock_guard<std::mutex> lock(configMutex);
-    try {
-        return config.value(path, defaultValue);
-    } catch (const std::exception& e) {
-        LOG_WARNING("Error reading config value at " + path + ": " + std::string(e.what()));
-        return defaultValue;
+const EngineSettings* EngineConfig::publish(std::unique_ptr<const EngineSettings> settings) {
+    const EngineSettings* next = settings.get();
+    snapshots.push_back(std::move(settings));
+    return current.exchange(next, std::memory_order_acq_rel);
+}
+
+void EngineConfig::watchConfig() {
+    std::string path;
+    std::filesystem::file_time_type lastSeen;
+    {
+        std::lock_guard<InstrumentedMutex> lock(configMutex);
+        path = configPath;
+        lastSeen = configWriteTime;
+    }
+
+    std::unique_lock<std::mutex> lock(watcherMutex);
+    while (!stopWatcher) {
+        double interval = std::max(getSettings().debug.configPollInterval, 0.05);
+        if (watcherCondition.wait_for(lock, std::chrono::duration<double>(interval), [this] { return stopWatcher; })) {
+            break;
+        }
+        lock.unlock();
+
+        // A half-written file fails to load and is retried on its next write
+        std::error_code error;
+        std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(path, error);
+        if (!error && writeTime != lastSeen) {
+            lastSeen = writeTime;
+            LOG_INFO("Config file changed, reloading: " + path);
+            loadConfig(path);
+        }
+        lock.lock();
     }
 }
 
-bool EngineConfig::validateConfig() const {
+bool EngineConfig::validateConfig(const json& candidate) const {
     // Check required sections
     const std::vector<std::string> requiredSections = {
         "engine", "physics", "rendering", "simulation",
@@ -74,7 +124,7 @@ bool EngineConfig::validateConfig() const {
     };
 
     for (const auto& section : requiredSections) {
-        if (!config.contains(section)) {
+        if (!candidate.contains(section)) {
             LOG_ERROR("Missing required section in config: " + section);
             return false;
         }
@@ -85,225 +135,323 @@ bool EngineConfig::validateConfig() const {
 
 // Physics settings
 bool EngineConfig::isGravityEnabled() const {
-    return getValue("physics.gravity.enabled", true);
+    return getSettings().physics.gravityEnabled;
 }
 
 double EngineConfig::getGravityConstant() const {
-    return getValue("physics.gravity.constant", 6.67430e-11);
+    return getSettings().physics.gravityConstant;
 }
 
 double EngineConfig::getMaxGravityDistance() const {
-    return getValue("physics.gravity.max_distance", 1e12);
+    return getSettings().physics.maxGravityDistance;
 }
 
 bool EngineConfig::isCollisionEnabled() const {
-    return getValue("physics.collision.enabled", true);
+    return getSettings().physics.collisionEnabled;
 }
 
 int EngineConfig::getCollisionIterations() const {
-    return getValue("physics.collision.resolution_iterations", 4);
+    return getSettings().physics.collisionIterations;
 }
 
 double EngineConfig::getFixedTimestep() const {
-    return getValue("physics.time.fixed_timestep", 0.016666);
+    return getSettings().physics.fixedTimestep;
 }
 
 double EngineConfig::getMaxTimestep() const {
-    return getValue("physics.time.max_timestep", 0.1);
+    return getSettings().physics.maxTimestep;
 }
 
 double EngineConfig::getTimeScale() const {
-    return getValue("physics.time.time_scale", 1.0);
+    return getSettings().physics.timeScale;
 }
 
 // Rendering settings
 int EngineConfig::getDefaultWindowWidth() const {
-    return getValue("rendering.window.default_width", 1920);
+    return getSettings().rendering.defaultWindowWidth;
 }
 
 int EngineConfig::getDefaultWindowHeight() const {
-    return getValue("rendering.window.default_height", 1080);
+    return getSettings().rendering.defaultWindowHeight;
 }
 
 bool EngineConfig::isVSyncEnabled() const {
-    return getValue("rendering.window.vsync", true);
+    return getSettings().rendering.vsync;
 }
 
 bool EngineConfig::isFullscreen() const {
-    return getValue("rendering.window.fullscreen", true);
+    return getSettings().rendering.fullscreen;
 }
 
 bool EngineConfig::isResizable() const {
-    return getValue("rendering.window.resizable", true);
+    return getSettings().rendering.resizable;
 }
 
 float EngineConfig::getFOV() const {
-    return getValue("rendering.camera.fov", 45.0f);
+    return getSettings().rendering.fov;
 }
 
 float EngineConfig::getNearPlane() const {
-    return getValue("rendering.camera.near_plane", 0.1f);
+    return getSettings().rendering.nearPlane;
 }
 
 float EngineConfig::getFarPlane() const {
-    return getValue("rendering.camera.far_plane", 1000.0f);
+    return getSettings().rendering.farPlane;
 }
 
 float EngineConfig::getCameraSpeed() const {
-    return getValue("rendering.camera.movement_speed", 2.5f);
+    return getSettings().rendering.cameraSpeed;
 }
 
 float EngineConfig::getSprintMultiplier() const {
-    return getValue("rendering.camera.sprint_multiplier", 5.0f);
+    return getSettings().rendering.sprintMultiplier;
 }
 
 float EngineConfig::getCameraSensitivity() const {
-    return getValue("rendering.camera.sensitivity", 0.1f);
+    return getSettings().rendering.cameraSensitivity;
+}
+
+bool EngineConfig::isLodEnabled() const {
+    return getSettings().rendering.lodEnabled;
+}
+
+float EngineConfig::getLodMaxScreenError() const {
+    return getSettings().rendering.lodMaxScreenError;
+}
+
+float EngineConfig::getLodHysteresis() const {
+    return getSettings().rendering.lodHysteresis;
 }
 
 // Simulation settings
 int EngineConfig::getMaxObjects() const {
-    return getValue("simulation.max_objects", 1000);
+    return getSettings().simulation.maxObjects;
 }
 
 bool EngineConfig::isSpatialPartitioningEnabled() const {
-    return getValue("simulation.spatial_partitioning.enabled", true);
+    return getSettings().simulation.spatialPartitioning;
 }
 
 double EngineConfig::getGridSize() const {
-    return getValue("simulation.spatial_partitioning.grid_size", 100.0);
+    return getSettings().simulation.gridSize;
 }
 
 int EngineConfig::getMaxObjectsPerCell() const {
-    return getValue("simulation.spatial_partitioning.max_objects_per_cell", 50);
+    return getSettings().simulation.maxObjectsPerCell;
 }
 
 int EngineConfig::getTrajectoryPredictionSteps() const {
-    return getValue("simulation.trajectory.prediction_steps", 100);
+    return getSettings().simulation.trajectoryPredictionSteps;
 }
 
 double EngineConfig::getTrajectoryStepSize() const {
-    return getValue("simulation.trajectory.step_size", 1.0);
+    return getSettings().simulation.trajectoryStepSize;
 }
 
 double EngineConfig::getMaxPredictionTime() const {
-    return getValue("simulation.trajectory.max_prediction_time", 1000.0);
+    return getSettings().simulation.maxPredictionTime;
 }
 
 // Resource management
 size_t EngineConfig::getCacheMaxSize() const {
-    return getValue("resource_management.cache.max_size", size_t(1024));
+    return getSettings().resources.cacheMaxSize;
 }
 
 std::string EngineConfig::getCachePolicy() const {
-    return getValue("resource_management.cache.policy", std::string("LRU"));
+    return getSettings().resources.cachePolicy;
 }
 
 bool EngineConfig::isPreloadAssetsEnabled() const {
-    return getValue("resource_management.cache.preload_assets", true);
+    return getSettings().resources.preloadAssets;
 }
 
 size_t EngineConfig::getMaxTextureMemory() const {
-    return getValue("resource_management.memory.max_texture_memory", size_t(1024));
+    return getSettings().resources.maxTextureMemory;
 }
 
 size_t EngineConfig::getMaxMeshMemory() const {
-    return getValue("resource_management.memory.max_mesh_memory", size_t(512));
+    return getSettings().resources.maxMeshMemory;
 }
 
 size_t EngineConfig::getMaxShaderMemory() const {
-    return getValue("resource_management.memory.max_shader_memory", size_t(64));
+    return getSettings().resources.maxShaderMemory;
+}
+
+size_t EngineConfig::getMemoryBudget(ResourceClass resourceClass) const {
+    // memory.max_*_memory values are given in megabytes
+    size_t megabytes = 0;
+    switch (resourceClass) {
+        case ResourceClass::Texture: megabytes = getMaxTextureMemory(); break;
+        case ResourceClass::Mesh: megabytes = getMaxMeshMemory(); break;
+        case ResourceClass::Shader: megabytes = getMaxShaderMemory(); break;
+    }
+    return megabytes * 1024 * 1024;
+}
+
+CachePolicy EngineConfig::getCachePolicyType() const {
+    std::string policy = getCachePolicy();
+    if (policy == "LFU") return CachePolicy::LFU;
+    if (policy == "FIFO") return CachePolicy::FIFO;
+    return CachePolicy::LRU;
+}
+
+std::string EngineConfig::getDerivedCacheDirectory() const {
+    return getSettings().resources.derivedCacheDirectory;
+}
+
+size_t EngineConfig::getDerivedCacheMaxSize() const {
+    return getSettings().resources.derivedCacheMaxSize;
 }
 
 // Debug settings
 std::string EngineConfig::getLogLevel() const {
-    return getValue("debug.logging.level", std::string("INFO"));
+    return getSettings().debug.logLevel;
 }
 
 std::string EngineConfig::getLogFile() const {
-    return getValue("debug.logging.file", std::string("engine.log"));
+    return getSettings().debug.logFile;
 }
 
 size_t EngineConfig::getMaxLogFileSize() const {
-    return getValue("debug.logging.max_file_size", size_t(10));
+    return getSettings().debug.maxLogFileSize;
 }
 
 int EngineConfig::getMaxLogFiles() const {
-    return getValue("debug.logging.max_files", 5);
+    return getSettings().debug.maxLogFiles;
+}
+
+bool EngineConfig::isConfigHotReloadEnabled() const {
+    return getSettings().debug.configHotReload;
+}
+
+double EngineConfig::getConfigPollInterval() const {
+    return getSettings().debug.configPollInterval;
 }
 
 bool EngineConfig::isProfilingEnabled() const {
-    return getValue("debug.profiling.enabled", true);
+    return getSettings().debug.profilingEnabled;
 }
 
 double EngineConfig::getProfilingInterval() const {
-    return getValue("debug.profiling.sample_interval", 0.1);
+    return getSettings().debug.profilingInterval;
+}
+
+std::string EngineConfig::getProfilingTraceFile() const {
+    return getSettings().debug.profilingTraceFile;
+}
+
+std::vector<std::string> EngineConfig::getProfilingMetrics() const {
+    return getSettings().debug.profilingMetrics;
+}
+
+double EngineConfig::getHistogramWindow() const {
+    return getSettings().debug.histogramWindow;
+}
+
+bool EngineConfig::isHardwareCountersEnabled() const {
+    return getSettings().debug.hardwareCounters;
+}
+
+bool EngineConfig::isSamplingProfilerEnabled() const {
+    return getSettings().debug.samplingEnabled;
+}
+
+int EngineConfig::getSamplingRate() const {
+    return getSettings().debug.samplingRate;
+}
+
+std::string EngineConfig::getSamplingOutput() const {
+    return getSettings().debug.samplingOutput;
+}
+
+bool EngineConfig::isHotPathAllocationCheckEnabled() const {
+    return getSettings().debug.checkHotPathAllocations;
+}
+
+int EngineConfig::getAllocationWarmupFrames() const {
+    return getSettings().debug.allocationWarmupFrames;
+}
+
+bool EngineConfig::isAbortOnHotPathAllocation() const {
+    return getSettings().debug.abortOnHotPathAllocation;
 }
 
 bool EngineConfig::isGridVisible() const {
-    return getValue("debug.visualization.show_grid", true);
+    return getSettings().debug.showGrid;
 }
 
 bool EngineConfig::isTrajectoryVisible() const {
-    return getValue("debug.visualization.show_trajectories", true);
+    return getSettings().debug.showTrajectories;
 }
 
 bool EngineConfig::isColliderVisible() const {
-    return getValue("debug.visualization.show_colliders", false);
+    return getSettings().debug.showColliders;
 }
 
 bool EngineConfig::isFPSVisible() const {
-    return getValue("debug.visualization.show_fps", true);
+    return getSettings().debug.showFPS;
+}
+
+int EngineConfig::getTextStressLabels() const {
+    return getSettings().debug.textStressLabels;
 }
 
 // Input settings
 std::string EngineConfig::getKeyBinding(const std::string& action) const {
-    std::string path = "input.keyboard.movement." + action;
-    std::string value = getValue(path, std::string());
-    if (value.empty()) {
-        path = "input.keyboard.camera." + action;
-        value = getValue(path, std::string());
-    }
-    return value;
+    const auto& bindings = getSettings().input.keyBindings;
+    auto it = bindings.find(action);
+    return it != bindings.end() ? it->second : std::string();
 }
 
 float EngineConfig::getMouseSensitivity() const {
-    return getValue("input.mouse.sensitivity", 0.1f);
+    return getSettings().input.mouseSensitivity;
 }
 
 bool EngineConfig::isMouseYInverted() const {
-    return getValue("input.mouse.invert_y", false);
+    return getSettings().input.invertMouseY;
 }
 
 // Optimization settings
 int EngineConfig::getPhysicsThreads() const {
-    return getValue("optimization.threading.physics_threads", 4);
+    return getSettings().optimization.physicsThreads;
 }
 
 int EngineConfig::getRenderThreads() const {
-    return getValue("optimization.threading.render_threads", 1);
+    return getSettings().optimization.renderThreads;
 }
 
 int EngineConfig::getIOThreads() const {
-    return getValue("optimization.threading.io_threads", 2);
+    return getSettings().optimization.ioThreads;
+}
+
+size_t EngineConfig::getFrameArenaSize() const {
+    return getSettings().optimization.frameArenaSize;
+}
+
+size_t EngineConfig::getScratchArenaSize() const {
+    return getSettings().optimization.scratchArenaSize;
+}
+
+size_t EngineConfig::getStreamingBufferSize() const {
+    return getSettings().optimization.streamingBufferSize;
 }
 
 bool EngineConfig::isBatchingEnabled() const {
-    return getValue("optimization.batching.enabled", true);
+    return getSettings().optimization.batchingEnabled;
 }
 
 int EngineConfig::getMaxBatchSize() const {
-    return getValue("optimization.batching.max_batch_size", 1000);
+    return getSettings().optimization.maxBatchSize;
 }
 
 bool EngineConfig::isCullingEnabled() const {
-    return getValue("optimization.culling.enabled", true);
+    return getSettings().optimization.cullingEnabled;
 }
 
 bool EngineConfig::isFrustumCullingEnabled() const {
-    return getValue("optimization.culling.frustum_culling", true);
+    return getSettings().optimization.frustumCulling;
 }
 
 bool EngineConfig::isOcclusionCullingEnabled() const {
-    return getValue("optimization.culling.occlusion_culling", true);
+    return getSettings().optimization.occlusionCulling;
 } 
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "EngineSettings.h"
+#include "EngineBackend.h"
+
+using json = nlohmann::json;
+
+namespace {
+// Overwrites target only when the key exists and converts cleanly
+template<typename T>
+void read(const json& source, const char* path, T& target) {
+    json::json_pointer pointer(path);
+    if (!source.contains(pointer)) {
+        return;
+    }
+    try {
+        target = source.at(pointer).get<T>();
+    } catch (const std::exception& e) {
+        LOG_WARNING("Error reading config value at " + std::string(path) + ": " + std::string(e.what()));
+    }
+}
+
+void readBindings(const json& source, const char* path, std::unordered_map<std::string, std::string>& bindings) {
+    json::json_pointer pointer(path);
+    if (!source.contains(pointer) || !source.at(pointer).is_object()) {
+        return;
+    }
+    for (const auto& [action, key] : source.at(pointer).items()) {
+        if (key.is_string()) {
+            bindings.emplace(action, key.get<std::string>());  // Earlier groups win
+        }
+    }
+}
+}
+
+EngineSettings EngineSettings::fromJson(const json& source) {
+    EngineSettings s;
+
+    // Physics
+    read(source, "/physics/gravity/enabled", s.physics.gravityEnabled);
+    read(source, "/physics/gravity/constant", s.physics.gravityConstant);
+    read(source, "/physics/gravity/max_distance", s.physics.maxGravityDistance);
+    read(source, "/physics/collision/enabled", s.physics.collisionEnabled);
+    read(source, "/physics/collision/resolution_iterations", s.physics.collisionIterations);
+    read(source, "/physics/time/fixed_timestep", s.physics.fixedTimestep);
+    read(source, "/physics/time/max_timestep", s.physics.maxTimestep);
+    read(source, "/physics/time/time_scale", s.physics.timeScale);
+
+    // Rendering
+    read(source, "/rendering/window/default_width", s.rendering.defaultWindowWidth);
+    read(source, "/rendering/window/default_height", s.rendering.defaultWindowHeight);
+    read(source, "/rendering/window/vsync", s.rendering.vsync);
+    read(source, "/rendering/window/fullscreen", s.rendering.fullscreen);
+    read(source, "/rendering/window/resizable", s.rendering.resizable);
+    read(source, "/rendering/camera/fov", s.rendering.fov);
+    read(source, "/rendering/camera/near_plane", s.rendering.nearPlane);
+    read(source, "/rendering/camera/far_plane", s.rendering.farPlane);
+    read(source, "/rendering/camera/movement_speed", s.rendering.cameraSpeed);
+    read(source, "/rendering/camera/sprint_multiplier", s.rendering.sprintMultiplier);
+    read(source, "/rendering/camera/sensitivity", s.rendering.cameraSensitivity);
+    read(source, "/rendering/lod/enabled", s.rendering.lodEnabled);
+    read(source, "/rendering/lod/max_screen_error", s.rendering.lodMaxScreenError);
+    read(source, "/rendering/lod/hysteresis", s.rendering.lodHysteresis);
+
+    // Simulation
+    read(source, "/simulation/max_objects", s.simulation.maxObjects);
+    read(source, "/simulation/spatial_partitioning/enabled", s.simulation.spatialPartitioning);
+    read(source, "/simulation/spatial_partitioning/grid_size", s.simulation.gridSize);
+    read(source, "/simulation/spatial_partitioning/max_objects_per_cell", s.simulation.maxObjectsPerCell);
+    read(source, "/simulation/trajectory/prediction_steps", s.simulation.trajectoryPredictionSteps);
+    read(source, "/simulation/trajectory/step_size", s.simulation.trajectoryStepSize);
+    read(source, "/simulation/trajectory/max_prediction_time", s.simulation.maxPredictionTime);
+
+    // Resource management
+    read(source, "/resource_management/cache/max_size", s.resources.cacheMaxSize);
+    read(source, "/resource_management/cache/policy", s.resources.cachePolicy);
+    read(source, "/resource_management/cache/preload_assets", s.resources.preloadAssets);
+    read(source, "/resource_management/memory/max_texture_memory", s.resources.maxTextureMemory);
+    read(source, "/resource_management/memory/max_mesh_memory", s.resources.maxMeshMemory);
+    read(source, "/resource_management/memory/max_shader_memory", s.resources.maxShaderMemory);
+    read(source, "/resource_management/derived_cache/directory", s.resources.derivedCacheDirectory);
+    read(source, "/resource_management/derived_cache/max_size", s.resources.derivedCacheMaxSize);
+
+    // Debug
+    read(source, "/debug/logging/level", s.debug.logLevel);
+    read(source, "/debug/logging/file", s.debug.logFile);
+    read(source, "/debug/logging/max_file_size", s.debug.maxLogFileSize);
+    read(source, "/debug/logging/max_files", s.debug.maxLogFiles);
+    read(source, "/debug/config/hot_reload", s.debug.configHotReload);
+    read(source, "/debug/config/poll_interval", s.debug.configPollInterval);
+    read(source, "/debug/profiling/enabled", s.debug.profilingEnabled);
+    read(source, "/debug/profiling/sample_interval", s.debug.profilingInterval);
+    read(source, "/debug/profiling/trace_file", s.debug.profilingTraceFile);
+    read(source, "/debug/profiling/metrics", s.debug.profilingMetrics);
+    read(source, "/debug/profiling/histogram_window", s.debug.histogramWindow);
+    read(source, "/debug/profiling/hardware_counters", s.debug.hardwareCounters);
+    read(source, "/debug/profiling/sampling/enabled", s.debug.samplingEnabled);
+    read(source, "/debug/profiling/sampling/rate_hz", s.debug.samplingRate);
+    read(source, "/debug/profiling/sampling/output", s.debug.samplingOutput);
+    read(source, "/debug/allocations/check_hot_paths", s.debug.checkHotPathAllocations);
+    read(source, "/debug/allocations/warmup_frames", s.debug.allocationWarmupFrames);
+    read(source, "/debug/allocations/abort_on_hot_path", s.debug.abortOnHotPathAllocation);
+    read(source, "/debug/visualization/show_grid", s.debug.showGrid);
+    read(source, "/debug/visualization/show_trajectories", s.debug.showTrajectories);
+    read(source, "/debug/visualization/show_colliders", s.debug.showColliders);
+    read(source, "/debug/visualization/show_fps", s.debug.showFPS);
+    read(source, "/debug/visualization/text_stress_labels", s.debug.textStressLabels);
+
+    // Input
+    readBindings(source, "/input/keyboard/movement", s.input.keyBindings);
+    readBindings(source, "/input/keyboard/camera", s.input.keyBindings);
+    read(source, "/input/mouse/sensitivity", s.input.mouseSensitivity);
+    read(source, "/input/mouse/invert_y", s.input.invertMouseY);
+
+    // Optimization
+    read(source, "/optimization/threading/physics_threads", s.optimization.physicsThreads);
+    read(source, "/optimization/threading/render_threads", s.optimization.renderThreads);
+    read(source, "/optimization/threading/io_threads", s.optimization.ioThreads);
+    read(source, "/optimization/memory/frame_arena_size", s.optimization.frameArenaSize);
+    read(source, "/optimization/memory/scratch_arena_size", s.optimization.scratchArenaSize);
+    read(source, "/optimization/memory/streaming_buffer_size", s.optimization.streamingBufferSize);
+    read(source, "/optimization/batching/enabled", s.optimization.batchingEnabled);
+    read(source, "/optimization/batching/max_batch_size", s.optimization.maxBatchSize);
+    read(source, "/optimization/culling/enabled", s.optimization.cullingEnabled);
+    read(source, "/optimization/culling/frustum_culling", s.optimization.frustumCulling);
+    read(source, "/optimization/culling/occlusion_culling", s.optimization.occlusionCulling);
+
+    return s;
+}
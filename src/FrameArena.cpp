@@ -0,0 +1,148 @@
+#include "FrameArena.h"
+#include "EngineConfig.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+size_t megabytes(size_t value) {
+    return std::max<size_t>(value, 1) * 1024 * 1024;
+}
+
+void atomicMax(std::atomic<size_t>& target, size_t value) {
+    size_t current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+}
+
+// LinearArena Implementation
+LinearArena::LinearArena(size_t capacity)
+    : buffer(new std::byte[capacity]),
+      capacity(capacity),
+      offset(0),
+      overflowBytes(0),
+      highWater(0),
+      overflowCount(0) {}
+
+LinearArena::~LinearArena() {
+    reset();
+}
+
+void* LinearArena::do_allocate(size_t bytes, size_t alignment) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(buffer.get());
+    size_t current = offset.load(std::memory_order_relaxed);
+    for (;;) {
+        size_t start = ((base + current + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base;
+        size_t end = start + bytes;
+        if (end > capacity) {
+            break;
+        }
+        if (offset.compare_exchange_weak(current, end, std::memory_order_relaxed)) {
+            return buffer.get() + start;
+        }
+    }
+
+    // Full: borrow from the heap until the next reset
+    void* memory = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    std::lock_guard<std::mutex> lock(overflowMutex);
+    overflowBlocks.emplace_back(memory, bytes);
+    overflowBytes.fetch_add(bytes, std::memory_order_relaxed);
+    overflowCount.fetch_add(1, std::memory_order_relaxed);
+    return memory;
+}
+
+void LinearArena::updateHighWater() {
+    atomicMax(highWater, getUsed());
+}
+
+void LinearArena::reset() {
+    rewind(Marker{0, 0});
+}
+
+LinearArena::Marker LinearArena::mark() const {
+    std::lock_guard<std::mutex> lock(overflowMutex);
+    return Marker{offset.load(std::memory_order_relaxed), overflowBlocks.size()};
+}
+
+void LinearArena::rewind(const Marker& marker) {
+    updateHighWater();
+    std::lock_guard<std::mutex> lock(overflowMutex);
+    // Overflow blocks come back in the order they were taken
+    while (overflowBlocks.size() > marker.overflowBlocks) {
+        auto [memory, bytes] = overflowBlocks.back();
+        overflowBlocks.pop_back();
+        std::pmr::new_delete_resource()->deallocate(memory, bytes);
+        overflowBytes.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+    offset.store(std::min(marker.offset, offset.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+}
+
+size_t LinearArena::getUsed() const {
+    return offset.load(std::memory_order_relaxed) + overflowBytes.load(std::memory_order_relaxed);
+}
+
+size_t LinearArena::getHighWater() const {
+    return std::max(highWater.load(std::memory_order_relaxed), getUsed());
+}
+
+// FrameArena Implementation
+FrameArena& FrameArena::getInstance() {
+    static FrameArena instance;
+    return instance;
+}
+
+FrameArena::FrameArena()
+    : scratchCapacity(megabytes(EngineConfig::getInstance().getScratchArenaSize())),
+      arenas{LinearArena(megabytes(EngineConfig::getInstance().getFrameArenaSize())),
+             LinearArena(megabytes(EngineConfig::getInstance().getFrameArenaSize()))},
+      currentIndex(0),
+      lastFrameUsage(0),
+      scratchHighWater(0) {}
+
+FrameArena::~FrameArena() {}
+
+void FrameArena::endFrame() {
+    size_t finished = currentIndex.load(std::memory_order_relaxed);
+    size_t next = finished ^ 1;
+    lastFrameUsage.store(arenas[finished].getUsed(), std::memory_order_relaxed);
+    // The other arena holds the frame before last, which nobody may still read
+    arenas[next].reset();
+    currentIndex.store(next, std::memory_order_release);
+}
+
+LinearArena& FrameArena::scratch() {
+    static thread_local LinearArena arena(getInstance().scratchCapacity);
+    return arena;
+}
+
+size_t FrameArena::getFrameHighWater() const {
+    return std::max(arenas[0].getHighWater(), arenas[1].getHighWater());
+}
+
+uint64_t FrameArena::getOverflowCount() const {
+    return arenas[0].getOverflowCount() + arenas[1].getOverflowCount();
+}
+
+void FrameArena::noteScratchUsage(size_t bytes) {
+    atomicMax(scratchHighWater, bytes);
+}
+
+std::string FrameArena::getReport() const {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1);
+    ss << "frame_arena: last_frame=" << getLastFrameUsage() / 1024.0 << "KB high_water="
+       << getFrameHighWater() / 1024.0 << "KB capacity=" << arenas[0].getCapacity() / 1024.0
+       << "KB overflows=" << getOverflowCount() << "\n";
+    ss << "scratch_arena: high_water=" << getScratchHighWater() / 1024.0 << "KB capacity="
+       << scratchCapacity / 1024.0 << "KB per thread\n";
+    return ss.str();
+}
+
+// ScratchScope Implementation
+ScratchScope::ScratchScope() : arena(FrameArena::scratch()), marker(arena.mark()) {}
+
+ScratchScope::~ScratchScope() {
+    FrameArena::getInstance().noteScratchUsage(arena.getUsed());
+    arena.rewind(marker);
+}
@@ -0,0 +1,81 @@
+#include "Frustum.h"
+#include "EngineBackend.h"
+#include <atomic>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FRUSTUM_SSE 1
+#endif
+
+void SphereArrays::resize(size_t count) {
+    x.resize(count);
+    y.resize(count);
+    z.resize(count);
+    radius.resize(count);
+}
+
+Frustum Frustum::fromViewProjection(const glm::mat4& m) {
+    // glm is column-major: m[column][row]
+    auto row = [&m](int i) { return glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]); };
+    glm::vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+    Frustum frustum;
+    frustum.planes = {r3 + r0, r3 - r0, r3 + r1, r3 - r1, r3 + r2, r3 - r2};
+    for (glm::vec4& plane : frustum.planes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) {
+            plane /= length;
+        }
+    }
+    return frustum;
+}
+
+bool Frustum::intersectsSphere(const glm::vec3& center, float radius) const {
+    for (const glm::vec4& plane : planes) {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t Frustum::cullSpheres(const SphereArrays& spheres, size_t first, size_t last, uint8_t* visible) const {
+    size_t count = 0;
+    size_t i = first;
+#ifdef FRUSTUM_SSE
+    // Four spheres per iteration; a sphere survives if no plane has it fully outside
+    for (; i + 4 <= last; i += 4) {
+        __m128 x = _mm_loadu_ps(spheres.x.data() + i);
+        __m128 y = _mm_loadu_ps(spheres.y.data() + i);
+        __m128 z = _mm_loadu_ps(spheres.z.data() + i);
+        __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(spheres.radius.data() + i));
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const glm::vec4& plane : planes) {
+            __m128 distance = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)), _mm_mul_ps(y, _mm_set1_ps(plane.y))),
+                _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(plane.z)), _mm_set1_ps(plane.w)));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negRadius));
+        }
+        int mask = _mm_movemask_ps(inside);
+        for (int lane = 0; lane < 4; ++lane) {
+            uint8_t in = static_cast<uint8_t>((mask >> lane) & 1);
+            visible[i + lane] = in;
+            count += in;
+        }
+    }
+#endif
+    for (; i < last; ++i) {
+        bool in = intersectsSphere(glm::vec3(spheres.x[i], spheres.y[i], spheres.z[i]), spheres.radius[i]);
+        visible[i] = in ? 1 : 0;
+        count += in ? 1 : 0;
+    }
+    return count;
+}
+
+size_t Frustum::cullSpheresParallel(const SphereArrays& spheres, uint8_t* visible, ThreadPool& pool) const {
+    std::atomic<size_t> count{0};
+    pool.parallelFor(spheres.size(), PARALLEL_THRESHOLD, [&](size_t begin, size_t end) {
+        count.fetch_add(cullSpheres(spheres, begin, end, visible), std::memory_order_relaxed);
+    });
+    return count.load(std::memory_order_relaxed);
+}
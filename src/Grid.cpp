@@ -1,5 +1,6 @@
 #include "Grid.h"
 #include "ResourceManager.h"
+#include "ShaderCache.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -20,80 +21,78 @@ Grid::Grid(float size, float step)
       fadeDistance(100.0f),
       needsUpdate(true) {
     
-    // Create and compile shaders
-    std::string vertexCode, fragmentCode;
-    std::ifstream vShaderFile, fShaderFile;
+    // Create and compile shaders straight from the asset pack or loose files
+    ResourceData vShaderFile, fShaderFile;
     
-    vShaderFile.open(ResourceManager::getResourcePath("shaders/grid.vert"));
-    fShaderFile.open(ResourceManager::getResourcePath("shaders/grid.frag"));
-    
-    if (!vShaderFile.is_open() || !fShaderFile.is_open()) {
+    if (!ResourceManager::loadResource("shaders/grid.vert", vShaderFile) ||
+        !ResourceManager::loadResource("shaders/grid.frag", fShaderFile)) {
         std::cerr << "Failed to open shader files" << std::endl;
         shaderProgram = 0; // Indicate shader loading failed
         return;
     }
     
-    std::stringstream vShaderStream, fShaderStream;
-    vShaderStream << vShaderFile.rdbuf();
-    fShaderStream << fShaderFile.rdbuf();
+    // Reuse the driver binary from a previous run when there is one
+    shaderProgram = ShaderCache::loadProgram(vShaderFile.view(), fShaderFile.view());
+    if (shaderProgram == 0) {
+        const char* vShaderCode = vShaderFile.view().data();
+        const char* fShaderCode = fShaderFile.view().data();
+        GLint vShaderLength = static_cast<GLint>(vShaderFile.size());
+        GLint fShaderLength = static_cast<GLint>(fShaderFile.size());
     
-    vertexCode = vShaderStream.str();
-    fragmentCode = fShaderStream.str();
+        unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(vertexShader, 1, &vShaderCode, &vShaderLength);
+        glCompileShader(vertexShader);
     
-    const char* vShaderCode = vertexCode.c_str();
-    const char* fShaderCode = fragmentCode.c_str();
+        // Check for vertex shader compile errors
+        int success;
+        char infoLog[512];
+        glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
+        if (!success) {
+            glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
+            std::cerr << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
+            glDeleteShader(vertexShader);
+            shaderProgram = 0; // Indicate shader loading failed
+            return;
+        }
     
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vShaderCode, NULL);
-    glCompileShader(vertexShader);
+        unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(fragmentShader, 1, &fShaderCode, &fShaderLength);
+        glCompileShader(fragmentShader);
     
-    // Check for vertex shader compile errors
-    int success;
-    char infoLog[512];
-    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-        std::cerr << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
-        glDeleteShader(vertexShader);
-        shaderProgram = 0; // Indicate shader loading failed
-        return;
-    }
-    
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fShaderCode, NULL);
-    glCompileShader(fragmentShader);
+        // Check for fragment shader compile errors
+        glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
+        if (!success) {
+            glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
+            std::cerr << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
+            glDeleteShader(fragmentShader);
+            glDeleteShader(vertexShader);
+            shaderProgram = 0; // Indicate shader loading failed
+            return;
+        }
     
-    // Check for fragment shader compile errors
-    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
-        std::cerr << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
-        glDeleteShader(fragmentShader);
-        glDeleteShader(vertexShader);
-        shaderProgram = 0; // Indicate shader loading failed
-        return;
-    }
+        shaderProgram = glCreateProgram();
+        glAttachShader(shaderProgram, vertexShader);
+        glAttachShader(shaderProgram, fragmentShader);
+        ShaderCache::prepareProgram(shaderProgram);
+        glLinkProgram(shaderProgram);
     
-    shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
+        // Check for linking errors
+        glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
+        if (!success) {
+            glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
+            std::cerr << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+            glDeleteProgram(shaderProgram);
+            glDeleteShader(vertexShader);
+            glDeleteShader(fragmentShader);
+            shaderProgram = 0; // Indicate shader loading failed
+            return;
+        }
     
-    // Check for linking errors
-    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-    if (!success) {
-        glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-        std::cerr << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
-        glDeleteProgram(shaderProgram);
         glDeleteShader(vertexShader);
         glDeleteShader(fragmentShader);
-        shaderProgram = 0; // Indicate shader loading failed
-        return;
+        ShaderCache::storeProgram(shaderProgram, vShaderFile.view(), fShaderFile.view());
     }
     
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-    
     // Get uniform locations for grid shader
     cameraPosLoc = glGetUniformLocation(shaderProgram, "cameraPos");
     gridSpacingLoc = glGetUniformLocation(shaderProgram, "gridSpacing");
@@ -0,0 +1,127 @@
+#include "Histogram.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+int highestBit(uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+}
+}
+
+Histogram::Histogram(size_t windowSlots)
+    : slots(new Slot[std::max<size_t>(windowSlots, 1)]),
+      slotCount(std::max<size_t>(windowSlots, 1)),
+      current(0) {
+    reset();
+}
+
+size_t Histogram::bucketIndex(uint64_t value) {
+    if (value < SUB_BUCKETS) {
+        return static_cast<size_t>(value);
+    }
+    int exponent = highestBit(value);
+    if (exponent >= MAX_EXPONENT) {
+        return BUCKET_COUNT - 1;
+    }
+    int shift = exponent - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS + static_cast<size_t>((value >> shift) - SUB_BUCKETS);
+}
+
+uint64_t Histogram::bucketUpperBound(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    int shift = static_cast<int>(index / SUB_BUCKETS) - 1;
+    uint64_t subBucket = index % SUB_BUCKETS + SUB_BUCKETS;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void Histogram::record(uint64_t value) {
+    Slot& slot = slots[current.load(std::memory_order_relaxed)];
+    slot.counts[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    uint64_t max = slot.max.load(std::memory_order_relaxed);
+    while (value > max && !slot.max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+}
+
+void Histogram::clearSlot(Slot& slot) {
+    for (auto& count : slot.counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    slot.max.store(0, std::memory_order_relaxed);
+}
+
+void Histogram::advance() {
+    // Clear the slot before publishing it; a writer still holding the old
+    // index just lands in the previous slot, which stays in the window
+    size_t next = (current.load(std::memory_order_relaxed) + 1) % slotCount;
+    clearSlot(slots[next]);
+    current.store(next, std::memory_order_release);
+}
+
+void Histogram::reset() {
+    for (size_t i = 0; i < slotCount; ++i) {
+        clearSlot(slots[i]);
+    }
+    current.store(0, std::memory_order_release);
+}
+
+uint64_t Histogram::merge(uint64_t* counts, uint64_t& max) const {
+    uint64_t total = 0;
+    max = 0;
+    std::fill(counts, counts + BUCKET_COUNT, 0);
+    for (size_t i = 0; i < slotCount; ++i) {
+        const Slot& slot = slots[i];
+        for (size_t b = 0; b < BUCKET_COUNT; ++b) {
+            uint64_t count = slot.counts[b].load(std::memory_order_relaxed);
+            counts[b] += count;
+            total += count;
+        }
+        max = std::max(max, slot.max.load(std::memory_order_relaxed));
+    }
+    return total;
+}
+
+uint64_t Histogram::valueAt(const uint64_t* counts, uint64_t total, uint64_t max, double fraction) {
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(std::ceil(std::clamp(fraction, 0.0, 1.0) * total));
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (size_t b = 0; b < BUCKET_COUNT; ++b) {
+        seen += counts[b];
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(b), max);
+        }
+    }
+    return max;
+}
+
+Histogram::Summary Histogram::summarize() const {
+    std::vector<uint64_t> counts(BUCKET_COUNT);
+    Summary summary;
+    summary.count = merge(counts.data(), summary.max);
+    summary.p50 = valueAt(counts.data(), summary.count, summary.max, 0.50);
+    summary.p90 = valueAt(counts.data(), summary.count, summary.max, 0.90);
+    summary.p99 = valueAt(counts.data(), summary.count, summary.max, 0.99);
+    return summary;
+}
+
+uint64_t Histogram::percentile(double fraction) const {
+    std::vector<uint64_t> counts(BUCKET_COUNT);
+    uint64_t max;
+    uint64_t total = merge(counts.data(), max);
+    return valueAt(counts.data(), total, max, fraction);
+}
@@ -0,0 +1,155 @@
+#include "InstrumentedMutex.h"
+#include "Profiler.h"
+#include "SamplingProfiler.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+uint64_t steadyNanos() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+}
+
+// InstrumentedMutex Implementation
+InstrumentedMutex::InstrumentedMutex(const char* name)
+    : stats(LockRegistry::getInstance().statsFor(name)) {}
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LOCK_CALLER_ADDRESS() reinterpret_cast<uintptr_t>(__builtin_return_address(0))
+#else
+#define LOCK_CALLER_ADDRESS() uintptr_t(0)
+#endif
+
+void InstrumentedMutex::lock() {
+    stats->acquisitions.fetch_add(1, std::memory_order_relaxed);
+    if (mutex.try_lock()) {
+        return;
+    }
+    lockContended(LOCK_CALLER_ADDRESS());
+}
+
+bool InstrumentedMutex::try_lock() {
+    if (mutex.try_lock()) {
+        stats->acquisitions.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void InstrumentedMutex::lockContended(uintptr_t site) {
+    uint64_t profileStart = Profiler::now();
+    uint64_t waitStart = steadyNanos();
+    mutex.lock();
+    uint64_t waited = steadyNanos() - waitStart;
+
+    stats->contentions.fetch_add(1, std::memory_order_relaxed);
+    stats->waitNanos.fetch_add(waited, std::memory_order_relaxed);
+    stats->waitTimes.record(waited);
+    {
+        std::lock_guard<std::mutex> lock(stats->sitesMutex);
+        LockStats::Site& entry = stats->sites[site];
+        entry.contentions++;
+        entry.waitNanos += waited;
+    }
+
+    // This mutex is held now, so never construct the Profiler from here: its
+    // construction reads EngineConfig and may log, both of which lock
+    Profiler* profiler = Profiler::peekInstance();
+    if (profiler && profiler->isEnabled()) {
+        const ProfileZone* zone = stats->zone.load(std::memory_order_acquire);
+        if (!zone) {
+            zone = profiler->internZone("wait: " + stats->name, "lock");
+            stats->zone.store(zone, std::memory_order_release);
+        }
+        profiler->record(zone, profileStart, Profiler::now(), ProfileScope::currentDepth());
+    }
+}
+
+// LockRegistry Implementation
+LockRegistry& LockRegistry::getInstance() {
+    static LockRegistry instance;
+    return instance;
+}
+
+LockRegistry::LockRegistry() {}
+
+LockRegistry::~LockRegistry() {}
+
+LockStats* LockRegistry::statsFor(const std::string& name) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (LockStats& stats : locks) {
+        if (stats.name == name) {
+            return &stats;
+        }
+    }
+    locks.emplace_back(name);
+    return &locks.back();
+}
+
+std::vector<LockRegistry::Summary> LockRegistry::getSummaries() const {
+    std::vector<Summary> summaries;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (const LockStats& stats : locks) {
+            Histogram::Summary waits = stats.waitTimes.summarize();
+            Summary summary;
+            summary.name = stats.name;
+            summary.acquisitions = stats.acquisitions.load(std::memory_order_relaxed);
+            summary.contentions = stats.contentions.load(std::memory_order_relaxed);
+            summary.totalWaitMs = stats.waitNanos.load(std::memory_order_relaxed) * 1e-6;
+            summary.p50WaitUs = waits.p50 * 1e-3;
+            summary.p99WaitUs = waits.p99 * 1e-3;
+            summary.maxWaitUs = waits.max * 1e-3;
+            {
+                std::lock_guard<std::mutex> sitesLock(stats.sitesMutex);
+                summary.sites.assign(stats.sites.begin(), stats.sites.end());
+            }
+            std::sort(summary.sites.begin(), summary.sites.end(), [](const auto& a, const auto& b) {
+                return a.second.waitNanos > b.second.waitNanos;
+            });
+            summaries.push_back(std::move(summary));
+        }
+    }
+    std::sort(summaries.begin(), summaries.end(), [](const Summary& a, const Summary& b) {
+        return a.totalWaitMs != b.totalWaitMs ? a.totalWaitMs > b.totalWaitMs : a.acquisitions > b.acquisitions;
+    });
+    return summaries;
+}
+
+std::string LockRegistry::getReport(size_t maxLocks, size_t maxSites) const {
+    std::vector<Summary> summaries = getSummaries();
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < summaries.size() && i < maxLocks; ++i) {
+        const Summary& summary = summaries[i];
+        if (summary.acquisitions == 0) {
+            break;  // Sorted last; never taken
+        }
+        double contended = summary.acquisitions ? 100.0 * summary.contentions / summary.acquisitions : 0.0;
+        ss << "lock " << summary.name << ": acquisitions=" << summary.acquisitions
+           << " contended=" << summary.contentions << " (" << contended << "%) wait_total="
+           << summary.totalWaitMs << "ms p50=" << summary.p50WaitUs << "us p99=" << summary.p99WaitUs
+           << "us max=" << summary.maxWaitUs << "us\n";
+        const auto& sites = summary.sites;
+        for (size_t s = 0; s < sites.size() && s < maxSites; ++s) {
+            ss << "    " << (sites[s].first ? SamplingProfiler::symbolize(sites[s].first) : "unknown")
+               << ": contended=" << sites[s].second.contentions
+               << " wait_total=" << sites[s].second.waitNanos * 1e-6 << "ms\n";
+        }
+    }
+    return ss.str();
+}
+
+void LockRegistry::reset() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (LockStats& stats : locks) {
+        stats.acquisitions.store(0, std::memory_order_relaxed);
+        stats.contentions.store(0, std::memory_order_relaxed);
+        stats.waitNanos.store(0, std::memory_order_relaxed);
+        stats.waitTimes.reset();
+        std::lock_guard<std::mutex> sitesLock(stats.sitesMutex);
+        stats.sites.clear();
+    }
+}
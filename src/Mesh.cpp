@@ -1,5 +1,17 @@
 #include "Mesh.h"
+#include "MeshCooker.h"
+#include "glm/gtc/packing.hpp"
 #include <cmath>
+#include <cstring>
+
+namespace {
+struct MeshHeader {
+    uint64_t vertexCount;
+    uint64_t triangleCount;
+    uint64_t nameLength;
+    Vector color;
+};
+}
 
 Mesh Mesh::createSphere(double radius, int segments) {
     Mesh sphere;
@@ -92,4 +104,75 @@ Mesh Mesh::createCube(double size) {
     }
     
     return cube;
-} 
\ No newline at end of file
+}
+
+std::vector<char> Mesh::serialize() const {
+    MeshHeader header{vertices.size(), triangles.size(), name.size(), color};
+    size_t vertexBytes = vertices.size() * sizeof(Vertex);
+    size_t triangleBytes = triangles.size() * sizeof(Triangle);
+
+    std::vector<char> bytes(sizeof(header) + vertexBytes + triangleBytes + name.size());
+    char* out = bytes.data();
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    std::memcpy(out, vertices.data(), vertexBytes);
+    out += vertexBytes;
+    std::memcpy(out, triangles.data(), triangleBytes);
+    out += triangleBytes;
+    std::memcpy(out, name.data(), name.size());
+    return bytes;
+}
+
+bool Mesh::deserialize(std::string_view bytes, Mesh& mesh) {
+    MeshHeader header;
+    if (bytes.size() < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    size_t vertexBytes = header.vertexCount * sizeof(Vertex);
+    size_t triangleBytes = header.triangleCount * sizeof(Triangle);
+    if (header.vertexCount > bytes.size() / sizeof(Vertex) ||
+        header.triangleCount > bytes.size() / sizeof(Triangle) ||
+        bytes.size() != sizeof(header) + vertexBytes + triangleBytes + header.nameLength) {
+        return false;
+    }
+
+    const char* in = bytes.data() + sizeof(header);
+    mesh.vertices.resize(header.vertexCount);
+    std::memcpy(mesh.vertices.data(), in, vertexBytes);
+    in += vertexBytes;
+    mesh.triangles.resize(header.triangleCount);
+    std::memcpy(mesh.triangles.data(), in, triangleBytes);
+    in += triangleBytes;
+    mesh.name.assign(in, header.nameLength);
+    mesh.color = header.color;
+    return true;
+}
+
+Mesh Mesh::fromView(const MeshView& view) {
+    Mesh mesh;
+    mesh.vertices.reserve(view.vertexCount);
+    for (size_t i = 0; i < view.vertexCount; ++i) {
+        const PackedVertex& packed = view.vertices[i];
+        glm::vec3 position = view.positionOffset +
+                             glm::vec3(packed.position[0], packed.position[1], packed.position[2]) / 32767.0f *
+                             view.positionScale;
+        glm::vec3 normal = MeshCooker::decodeOctahedral(packed.normal);
+        Vertex vertex;
+        vertex.position = Vector(position.x, position.y, position.z);
+        vertex.normal = Vector(normal.x, normal.y, normal.z);
+        vertex.texCoord = Vector(glm::unpackHalf1x16(packed.texCoord[0]), glm::unpackHalf1x16(packed.texCoord[1]), 0);
+        mesh.vertices.push_back(vertex);
+    }
+
+    mesh.triangles.reserve(view.indexCount / 3);
+    for (size_t i = 0; i + 2 < view.indexCount; i += 3) {
+        uint32_t a = view.index(i);
+        uint32_t b = view.index(i + 1);
+        uint32_t c = view.index(i + 2);
+        if (a < view.vertexCount && b < view.vertexCount && c < view.vertexCount) {
+            mesh.triangles.push_back(Triangle{static_cast<int>(a), static_cast<int>(b), static_cast<int>(c)});
+        }
+    }
+    return mesh;
+}
@@ -0,0 +1,384 @@
+#include "MeshCooker.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+#include "glm/gtc/packing.hpp"
+
+namespace {
+// Forsyth's tuning: a 32-entry LRU model, the last triangle's vertices score a
+// flat 0.75, and vertices with few triangles left are boosted so they finish
+constexpr size_t FORSYTH_CACHE_SIZE = 32;
+constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+constexpr float CACHE_DECAY_POWER = 1.5f;
+constexpr float VALENCE_BOOST_SCALE = 2.0f;
+constexpr float VALENCE_BOOST_POWER = 0.5f;
+constexpr float OVERDRAW_ACMR_TOLERANCE = 1.05f;
+
+float vertexScore(int cachePosition, uint32_t remainingTriangles) {
+    if (remainingTriangles == 0) {
+        return -1.0f;  // Nothing left to draw with it
+    }
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            score = LAST_TRIANGLE_SCORE;
+        } else {
+            float scale = 1.0f / (FORSYTH_CACHE_SIZE - 3);
+            score = std::pow(1.0f - (cachePosition - 3) * scale, CACHE_DECAY_POWER);
+        }
+    }
+    return score + VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remainingTriangles), -VALENCE_BOOST_POWER);
+}
+
+// Bytes of a packed vertex, for deduplication
+struct VertexKey {
+    uint64_t bits[2];
+    bool operator==(const VertexKey& other) const { return bits[0] == other.bits[0] && bits[1] == other.bits[1]; }
+};
+
+struct VertexKeyHash {
+    size_t operator()(const VertexKey& key) const {
+        return std::hash<uint64_t>()(key.bits[0] ^ (key.bits[1] * 0x9E3779B97F4A7C15ull));
+    }
+};
+
+int16_t toSnorm16(double value) {
+    return static_cast<int16_t>(std::lround(std::clamp(value, -1.0, 1.0) * 32767.0));
+}
+
+// FIFO cache: a vertex is resident if it was inserted within the last cacheSize misses
+class FifoCache {
+public:
+    FifoCache(size_t vertexCount, size_t cacheSize) : insertedAt(vertexCount, 0), size(cacheSize) {}
+
+    bool access(uint32_t vertex) {
+        if (insertedAt[vertex] != 0 && misses - insertedAt[vertex] < size) {
+            return true;
+        }
+        insertedAt[vertex] = ++misses;
+        return false;
+    }
+
+private:
+    std::vector<uint64_t> insertedAt;  // Miss count after inserting, 0 if never
+    size_t size;
+    uint64_t misses = 0;
+};
+}
+
+void MeshCooker::encodeOctahedral(const glm::vec3& normal, int16_t out[2]) {
+    float sum = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    glm::vec2 p = sum > 0.0f ? glm::vec2(normal.x, normal.y) / sum : glm::vec2(0.0f);
+    if (normal.z < 0.0f) {
+        // Fold the lower hemisphere over the diagonals
+        glm::vec2 folded = (1.0f - glm::abs(glm::vec2(p.y, p.x)));
+        p = glm::vec2(p.x >= 0.0f ? folded.x : -folded.x, p.y >= 0.0f ? folded.y : -folded.y);
+    }
+    out[0] = toSnorm16(p.x);
+    out[1] = toSnorm16(p.y);
+}
+
+glm::vec3 MeshCooker::decodeOctahedral(const int16_t in[2]) {
+    glm::vec2 e(std::max(in[0] / 32767.0f, -1.0f), std::max(in[1] / 32767.0f, -1.0f));
+    glm::vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+    float t = std::max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return glm::normalize(n);
+}
+
+float MeshCooker::computeACMR(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize) {
+    if (indices.size() < 3) {
+        return 0.0f;
+    }
+    FifoCache cache(vertexCount, cacheSize);
+    size_t misses = 0;
+    for (uint32_t index : indices) {
+        misses += cache.access(index) ? 0 : 1;
+    }
+    return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
+
+void MeshCooker::optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2) {
+        return;
+    }
+
+    // Vertex -> triangle adjacency; each vertex's live triangles are the first remaining[v] of its range
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (uint32_t index : indices) {
+        remaining[index]++;
+    }
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        offsets[v + 1] = offsets[v] + remaining[v];
+    }
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (size_t k = 0; k < 3; ++k) {
+            adjacency[fill[indices[3 * t + k]]++] = static_cast<uint32_t>(t);
+        }
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        vertexScores[v] = vertexScore(-1, remaining[v]);
+    }
+    std::vector<float> triangleScores(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        triangleScores[t] = vertexScores[indices[3 * t]] + vertexScores[indices[3 * t + 1]] +
+                            vertexScores[indices[3 * t + 2]];
+    }
+    std::vector<bool> emitted(triangleCount, false);
+
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> nextCache;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    nextCache.reserve(FORSYTH_CACHE_SIZE + 3);
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+
+    size_t best = static_cast<size_t>(std::max_element(triangleScores.begin(), triangleScores.end()) -
+                                      triangleScores.begin());
+    size_t cursor = 0;  // Fallback scan when no cached vertex has triangles left
+    while (true) {
+        if (best == triangleCount) {
+            while (cursor < triangleCount && emitted[cursor]) {
+                ++cursor;
+            }
+            if (cursor == triangleCount) {
+                break;
+            }
+            best = cursor;
+        }
+
+        emitted[best] = true;
+        const uint32_t* triangle = &indices[3 * best];
+        nextCache.assign(triangle, triangle + 3);
+        for (size_t k = 0; k < 3; ++k) {
+            uint32_t v = triangle[k];
+            output.push_back(v);
+            uint32_t* live = &adjacency[offsets[v]];
+            std::swap(*std::find(live, live + remaining[v], static_cast<uint32_t>(best)), live[remaining[v] - 1]);
+            remaining[v]--;
+        }
+        for (uint32_t v : cache) {
+            if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+                nextCache.push_back(v);
+            }
+        }
+        cache.swap(nextCache);
+
+        // Rescore everything whose cache position moved, including the evicted tail
+        for (size_t i = 0; i < cache.size(); ++i) {
+            uint32_t v = cache[i];
+            cachePosition[v] = i < FORSYTH_CACHE_SIZE ? static_cast<int>(i) : -1;
+            vertexScores[v] = vertexScore(cachePosition[v], remaining[v]);
+        }
+        best = triangleCount;
+        float bestScore = -std::numeric_limits<float>::max();
+        for (uint32_t v : cache) {
+            for (uint32_t i = offsets[v]; i < offsets[v] + remaining[v]; ++i) {
+                uint32_t t = adjacency[i];
+                float score = vertexScores[indices[3 * t]] + vertexScores[indices[3 * t + 1]] +
+                              vertexScores[indices[3 * t + 2]];
+                triangleScores[t] = score;
+                if (score > bestScore) {
+                    bestScore = score;
+                    best = t;
+                }
+            }
+        }
+        if (cache.size() > FORSYTH_CACHE_SIZE) {
+            cache.resize(FORSYTH_CACHE_SIZE);
+        }
+    }
+    indices.swap(output);
+}
+
+void MeshCooker::optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2) {
+        return;
+    }
+
+    // A cluster starts wherever the cache has to be refilled from scratch, so
+    // clusters can be reordered without losing much vertex reuse
+    struct Cluster {
+        size_t first;
+        size_t count;
+        float key;
+    };
+    std::vector<Cluster> clusters;
+    FifoCache cache(positions.size(), ACMR_CACHE_SIZE);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        size_t misses = 0;
+        for (size_t k = 0; k < 3; ++k) {
+            misses += cache.access(indices[3 * t + k]) ? 0 : 1;
+        }
+        if (t == 0 || misses == 3) {
+            clusters.push_back(Cluster{t, 0, 0.0f});
+        }
+        clusters.back().count++;
+    }
+    if (clusters.size() < 2) {
+        return;
+    }
+
+    auto corner = [&](size_t t, size_t k) { return positions[indices[3 * t + k]]; };
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        float area = glm::length(glm::cross(corner(t, 1) - corner(t, 0), corner(t, 2) - corner(t, 0)));
+        meshCentroid += area * (corner(t, 0) + corner(t, 1) + corner(t, 2)) / 3.0f;
+        meshArea += area;
+    }
+    if (meshArea > 0.0f) {
+        meshCentroid /= meshArea;
+    }
+
+    // Clusters facing away from the middle of the mesh tend to occlude the
+    // rest, so they go first
+    for (Cluster& cluster : clusters) {
+        glm::vec3 centroid(0.0f);
+        glm::vec3 normal(0.0f);
+        float area = 0.0f;
+        for (size_t t = cluster.first; t < cluster.first + cluster.count; ++t) {
+            glm::vec3 cross = glm::cross(corner(t, 1) - corner(t, 0), corner(t, 2) - corner(t, 0));
+            float triangleArea = glm::length(cross);
+            centroid += triangleArea * (corner(t, 0) + corner(t, 1) + corner(t, 2)) / 3.0f;
+            normal += cross;
+            area += triangleArea;
+        }
+        float normalLength = glm::length(normal);
+        if (area > 0.0f && normalLength > 0.0f) {
+            cluster.key = glm::dot(centroid / area - meshCentroid, normal / normalLength);
+        }
+    }
+    std::stable_sort(clusters.begin(), clusters.end(),
+                     [](const Cluster& a, const Cluster& b) { return a.key > b.key; });
+
+    std::vector<uint32_t> reordered;
+    reordered.reserve(indices.size());
+    for (const Cluster& cluster : clusters) {
+        reordered.insert(reordered.end(), indices.begin() + 3 * cluster.first,
+                         indices.begin() + 3 * (cluster.first + cluster.count));
+    }
+    float before = computeACMR(indices, positions.size());
+    if (computeACMR(reordered, positions.size()) <= before * OVERDRAW_ACMR_TOLERANCE) {
+        indices.swap(reordered);
+    }
+}
+
+CookedMesh MeshCooker::cook(const Mesh& mesh) {
+    const std::vector<Vertex>& vertices = mesh.getVertices();
+    const std::vector<Triangle>& triangles = mesh.getTriangles();
+    CookedMesh cooked;
+    cooked.stats.sourceVertices = vertices.size();
+    cooked.stats.sourceTriangles = triangles.size();
+    cooked.stats.sourceBytes = vertices.size() * 8 * sizeof(float) + triangles.size() * 3 * sizeof(uint32_t);
+
+    // Triangles with an index out of range are dropped up front
+    std::vector<uint32_t> sourceIndices;
+    sourceIndices.reserve(triangles.size() * 3);
+    for (const Triangle& triangle : triangles) {
+        int corners[3] = {triangle.v1, triangle.v2, triangle.v3};
+        if (std::all_of(corners, corners + 3, [&](int v) { return v >= 0 && static_cast<size_t>(v) < vertices.size(); })) {
+            sourceIndices.insert(sourceIndices.end(), corners, corners + 3);
+        }
+    }
+    if (vertices.empty() || sourceIndices.empty()) {
+        return cooked;
+    }
+    cooked.stats.acmrBefore = computeACMR(sourceIndices, vertices.size());
+
+    // Quantize positions within the bounds; a flat axis keeps scale 1
+    glm::dvec3 low(std::numeric_limits<double>::max());
+    glm::dvec3 high(std::numeric_limits<double>::lowest());
+    for (const Vertex& vertex : vertices) {
+        glm::dvec3 p(vertex.position.x, vertex.position.y, vertex.position.z);
+        low = glm::min(low, p);
+        high = glm::max(high, p);
+    }
+    glm::dvec3 offset = (low + high) * 0.5;
+    glm::dvec3 scale = (high - low) * 0.5;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (scale[axis] <= 0.0) {
+            scale[axis] = 1.0;
+        }
+    }
+    cooked.positionOffset = glm::vec3(offset);
+    cooked.positionScale = glm::vec3(scale);
+
+    // Pack, then merge vertices whose packed bytes match
+    std::vector<uint32_t> remap(vertices.size());
+    std::unordered_map<VertexKey, uint32_t, VertexKeyHash> unique;
+    unique.reserve(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const Vertex& vertex = vertices[i];
+        PackedVertex packed{};
+        packed.position[0] = toSnorm16((vertex.position.x - offset.x) / scale.x);
+        packed.position[1] = toSnorm16((vertex.position.y - offset.y) / scale.y);
+        packed.position[2] = toSnorm16((vertex.position.z - offset.z) / scale.z);
+        encodeOctahedral(glm::vec3(vertex.normal.x, vertex.normal.y, vertex.normal.z), packed.normal);
+        packed.texCoord[0] = glm::packHalf1x16(static_cast<float>(vertex.texCoord.x));
+        packed.texCoord[1] = glm::packHalf1x16(static_cast<float>(vertex.texCoord.y));
+
+        VertexKey key;
+        std::memcpy(key.bits, &packed, sizeof(packed));
+        auto [it, inserted] = unique.emplace(key, static_cast<uint32_t>(cooked.vertices.size()));
+        if (inserted) {
+            cooked.vertices.push_back(packed);
+        }
+        remap[i] = it->second;
+    }
+
+    // Triangles whose corners quantized onto each other cover no pixels
+    auto samePosition = [&](uint32_t a, uint32_t b) {
+        return std::memcmp(cooked.vertices[a].position, cooked.vertices[b].position, 3 * sizeof(int16_t)) == 0;
+    };
+    std::vector<uint32_t> indices;
+    indices.reserve(sourceIndices.size());
+    for (size_t i = 0; i < sourceIndices.size(); i += 3) {
+        uint32_t a = remap[sourceIndices[i]];
+        uint32_t b = remap[sourceIndices[i + 1]];
+        uint32_t c = remap[sourceIndices[i + 2]];
+        if (!samePosition(a, b) && !samePosition(b, c) && !samePosition(a, c)) {
+            indices.insert(indices.end(), {a, b, c});
+        }
+    }
+
+    optimizeVertexCache(indices, cooked.vertices.size());
+    std::vector<glm::vec3> positions(cooked.vertices.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const int16_t* q = cooked.vertices[i].position;
+        positions[i] = cooked.positionOffset + glm::vec3(q[0], q[1], q[2]) / 32767.0f * cooked.positionScale;
+    }
+    optimizeOverdraw(indices, positions);
+    cooked.stats.acmrAfter = computeACMR(indices, cooked.vertices.size());
+
+    if (cooked.vertices.size() <= std::numeric_limits<uint16_t>::max() + size_t(1)) {
+        cooked.indices16.assign(indices.begin(), indices.end());
+    } else {
+        cooked.indices32.swap(indices);
+    }
+    cooked.stats.cookedBytes = cooked.vertices.size() * sizeof(PackedVertex) + cooked.indexCount() * cooked.indexSize();
+    return cooked;
+}
+
+std::string MeshCooker::describe(const CookedMesh& mesh) {
+    const CookedMesh::Stats& stats = mesh.stats;
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(3) << stats.sourceVertices << " -> " << mesh.vertices.size()
+       << " vertices, " << stats.sourceTriangles << " -> " << mesh.indexCount() / 3 << " triangles, "
+       << stats.sourceBytes << " -> " << stats.cookedBytes << " bytes, ACMR " << stats.acmrBefore << " -> "
+       << stats.acmrAfter;
+    return ss.str();
+}
@@ -0,0 +1,206 @@
+#include "MeshFile.h"
+#include "DerivedAssetCache.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+uint64_t alignOffset(uint64_t offset) {
+    return (offset + MeshFile::DATA_ALIGNMENT - 1) / MeshFile::DATA_ALIGNMENT * MeshFile::DATA_ALIGNMENT;
+}
+
+bool inRange(uint64_t offset, uint64_t size, size_t total) {
+    return offset <= total && size <= total - offset;
+}
+
+template<typename Index>
+bool indicesInRange(const uint8_t* data, uint32_t count, uint32_t vertexCount) {
+    const Index* indices = reinterpret_cast<const Index*>(data);
+    Index largest = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        largest = std::max(largest, indices[i]);
+    }
+    return count == 0 || largest < vertexCount;
+}
+}
+
+bool MeshFile::open(const std::string& path) {
+    close();
+    if (!file.open(path, AccessHint::Sequential)) {
+        return false;
+    }
+    if (!parse(file.view(), path)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool MeshFile::open(MappedFile&& mapping, std::string_view bytes) {
+    close();
+    file = std::move(mapping);
+    if (!parse(bytes, "mapped mesh")) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool MeshFile::openCached(const std::string& key, const std::function<std::vector<uint8_t>()>& build) {
+    MappedFile mapping;
+    std::string_view payload;
+    if (DerivedAssetCache::getInstance().load(key, mapping, payload) && open(std::move(mapping), payload)) {
+        return true;
+    }
+
+    close();
+    owned = build();
+    if (owned.empty()) {
+        return false;
+    }
+    DerivedAssetCache::getInstance().store(key, owned.data(), owned.size());
+    if (!parse(std::string_view(reinterpret_cast<const char*>(owned.data()), owned.size()), "built mesh")) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MeshFile::close() {
+    file.close();
+    owned.clear();
+    owned.shrink_to_fit();
+    header = nullptr;
+    lods = nullptr;
+    base = nullptr;
+}
+
+bool MeshFile::parse(std::string_view bytes, const std::string& source) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(bytes.data());
+    if (bytes.size() < sizeof(FileHeader) || reinterpret_cast<uintptr_t>(data) % alignof(FileHeader) != 0) {
+        LOG_ERROR("Invalid mesh file: " + source);
+        return false;
+    }
+    const FileHeader* fileHeader = reinterpret_cast<const FileHeader*>(data);
+    if (fileHeader->magic != MAGIC || fileHeader->version != VERSION ||
+        fileHeader->vertexFormat != VERTEX_FORMAT_PACKED16 || fileHeader->lodCount == 0 ||
+        fileHeader->lodTableOffset % alignof(LodEntry) != 0 ||
+        !inRange(fileHeader->lodTableOffset, uint64_t(fileHeader->lodCount) * sizeof(LodEntry), bytes.size())) {
+        LOG_ERROR("Invalid mesh file: " + source);
+        return false;
+    }
+
+    const LodEntry* table = reinterpret_cast<const LodEntry*>(data + fileHeader->lodTableOffset);
+    for (uint32_t i = 0; i < fileHeader->lodCount; ++i) {
+        const LodEntry& lod = table[i];
+        if ((lod.indexSize != sizeof(uint16_t) && lod.indexSize != sizeof(uint32_t)) ||
+            lod.vertexOffset % DATA_ALIGNMENT != 0 || lod.indexOffset % DATA_ALIGNMENT != 0 ||
+            !inRange(lod.vertexOffset, uint64_t(lod.vertexCount) * sizeof(PackedVertex), bytes.size()) ||
+            !inRange(lod.indexOffset, uint64_t(lod.indexCount) * lod.indexSize, bytes.size()) ||
+            lod.indexCount % 3 != 0) {
+            LOG_ERROR("Invalid mesh file LOD " + std::to_string(i) + ": " + source);
+            return false;
+        }
+        // One pass over the indices here keeps every later draw and CPU walk in bounds
+        const uint8_t* indices = data + lod.indexOffset;
+        bool valid = lod.indexSize == sizeof(uint16_t)
+            ? indicesInRange<uint16_t>(indices, lod.indexCount, lod.vertexCount)
+            : indicesInRange<uint32_t>(indices, lod.indexCount, lod.vertexCount);
+        if (!valid) {
+            LOG_ERROR("Mesh file LOD " + std::to_string(i) + " indexes past its vertices: " + source);
+            return false;
+        }
+    }
+
+    header = fileHeader;
+    lods = table;
+    base = data;
+    return true;
+}
+
+MeshView MeshFile::getLod(size_t lod) const {
+    const LodEntry& entry = lods[lod];
+    MeshView view;
+    view.vertices = reinterpret_cast<const PackedVertex*>(base + entry.vertexOffset);
+    view.vertexCount = entry.vertexCount;
+    view.indices = base + entry.indexOffset;
+    view.indexCount = entry.indexCount;
+    view.indexSize = entry.indexSize;
+    view.positionOffset = glm::vec3(entry.positionOffset[0], entry.positionOffset[1], entry.positionOffset[2]);
+    view.positionScale = glm::vec3(entry.positionScale[0], entry.positionScale[1], entry.positionScale[2]);
+    return view;
+}
+
+glm::vec3 MeshFile::getBoundsMin() const {
+    return header ? glm::vec3(header->boundsMin[0], header->boundsMin[1], header->boundsMin[2]) : glm::vec3(0.0f);
+}
+
+glm::vec3 MeshFile::getBoundsMax() const {
+    return header ? glm::vec3(header->boundsMax[0], header->boundsMax[1], header->boundsMax[2]) : glm::vec3(0.0f);
+}
+
+std::vector<uint8_t> MeshFile::serialize(const std::vector<LodSource>& sources) {
+    if (sources.empty()) {
+        return {};
+    }
+
+    FileHeader fileHeader{};
+    fileHeader.magic = MAGIC;
+    fileHeader.version = VERSION;
+    fileHeader.lodCount = static_cast<uint32_t>(sources.size());
+    fileHeader.vertexFormat = VERTEX_FORMAT_PACKED16;
+    fileHeader.lodTableOffset = sizeof(FileHeader);
+
+    // Bounds of the finest LOD, from the positions as the GPU will decode them
+    const CookedMesh& finest = *sources.front().mesh;
+    glm::vec3 low(std::numeric_limits<float>::max());
+    glm::vec3 high(std::numeric_limits<float>::lowest());
+    float radius = 0.0f;
+    for (const PackedVertex& vertex : finest.vertices) {
+        glm::vec3 p = finest.positionOffset +
+                      glm::vec3(vertex.position[0], vertex.position[1], vertex.position[2]) / 32767.0f *
+                      finest.positionScale;
+        low = glm::min(low, p);
+        high = glm::max(high, p);
+        radius = std::max(radius, glm::length(p));
+    }
+    if (finest.vertices.empty()) {
+        low = high = glm::vec3(0.0f);
+    }
+    std::memcpy(fileHeader.boundsMin, &low[0], sizeof(fileHeader.boundsMin));
+    std::memcpy(fileHeader.boundsMax, &high[0], sizeof(fileHeader.boundsMax));
+    fileHeader.boundsRadius = radius;
+
+    std::vector<LodEntry> table(sources.size());
+    uint64_t offset = alignOffset(fileHeader.lodTableOffset + table.size() * sizeof(LodEntry));
+    for (size_t i = 0; i < sources.size(); ++i) {
+        const CookedMesh& mesh = *sources[i].mesh;
+        LodEntry& entry = table[i];
+        entry.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+        entry.indexCount = static_cast<uint32_t>(mesh.indexCount());
+        entry.indexSize = static_cast<uint32_t>(mesh.indexSize());
+        entry.geometricError = sources[i].geometricError;
+        std::memcpy(entry.positionOffset, &mesh.positionOffset[0], sizeof(entry.positionOffset));
+        std::memcpy(entry.positionScale, &mesh.positionScale[0], sizeof(entry.positionScale));
+        entry.vertexOffset = offset;
+        offset = alignOffset(offset + uint64_t(entry.vertexCount) * sizeof(PackedVertex));
+        entry.indexOffset = offset;
+        offset = alignOffset(offset + uint64_t(entry.indexCount) * entry.indexSize);
+    }
+
+    std::vector<uint8_t> bytes(offset, 0);
+    std::memcpy(bytes.data(), &fileHeader, sizeof(fileHeader));
+    std::memcpy(bytes.data() + fileHeader.lodTableOffset, table.data(), table.size() * sizeof(LodEntry));
+    for (size_t i = 0; i < sources.size(); ++i) {
+        const CookedMesh& mesh = *sources[i].mesh;
+        std::memcpy(bytes.data() + table[i].vertexOffset, mesh.vertices.data(),
+                    mesh.vertices.size() * sizeof(PackedVertex));
+        std::memcpy(bytes.data() + table[i].indexOffset, mesh.indexData(), mesh.indexCount() * mesh.indexSize());
+    }
+    return bytes;
+}
+
+bool MeshFile::write(const std::string& path, const std::vector<LodSource>& sources) {
+    std::vector<uint8_t> bytes = serialize(sources);
+    return !bytes.empty() && FileSystem::getInstance().saveFile(path, bytes);
+}
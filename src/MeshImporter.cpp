@@ -0,0 +1,796 @@
+#include "MeshImporter.h"
+#include "EngineBackend.h"
+#include "Profiler.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <unordered_map>
+
+using json = nlohmann::json;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t NO_INDEX = 0xFFFFFFFFu;  // Corner has no texture coordinate or normal
+constexpr uint32_t BAD_INDEX = 0xFFFFFFFEu;  // Corner points outside the file's attributes
+constexpr size_t MIN_VERTEX_SHARE = 16384;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::string lowerExtension(const std::string& path) {
+    std::string extension = std::filesystem::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension;
+}
+
+// Area-weighted face normals summed into each vertex, then normalized; only
+// vertices in [firstVertex, vertices.size()) whose normal is still zero are set
+void computeMissingNormals(std::vector<Vertex>& vertices, const std::vector<Triangle>& triangles,
+                           size_t firstVertex, size_t firstTriangle) {
+    std::vector<Vector> sums(vertices.size() - firstVertex);
+    for (size_t i = firstTriangle; i < triangles.size(); ++i) {
+        const Triangle& t = triangles[i];
+        Vector face = (vertices[t.v2].position - vertices[t.v1].position)
+                          .cross(vertices[t.v3].position - vertices[t.v1].position);
+        sums[t.v1 - firstVertex] = sums[t.v1 - firstVertex] + face;
+        sums[t.v2 - firstVertex] = sums[t.v2 - firstVertex] + face;
+        sums[t.v3 - firstVertex] = sums[t.v3 - firstVertex] + face;
+    }
+    for (size_t i = firstVertex; i < vertices.size(); ++i) {
+        Vector& normal = vertices[i].normal;
+        if (normal.x == 0.0 && normal.y == 0.0 && normal.z == 0.0) {
+            normal = sums[i - firstVertex].normalize();
+        }
+    }
+}
+
+// --- OBJ ---
+
+struct Corner {
+    uint32_t position;
+    uint32_t texCoord;
+    uint32_t normal;
+
+    bool operator==(const Corner& other) const {
+        return position == other.position && texCoord == other.texCoord && normal == other.normal;
+    }
+};
+
+struct CornerHash {
+    size_t operator()(const Corner& c) const {
+        uint64_t h = c.position * 0x9E3779B97F4A7C15ull;
+        h ^= (uint64_t(c.texCoord) * 0xC2B2AE3D27D4EB4Full) + (h >> 29);
+        h ^= (uint64_t(c.normal) * 0x165667B19E3779F9ull) + (h >> 32);
+        return static_cast<size_t>(h);
+    }
+};
+
+enum class ObjLine { Position, TexCoord, Normal, Face, Other };
+
+struct ObjChunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    size_t positionCount = 0;  // Counted in the first pass
+    size_t texCoordCount = 0;
+    size_t normalCount = 0;
+    size_t positionBase = 0;  // Attributes of earlier chunks
+    size_t texCoordBase = 0;
+    size_t normalBase = 0;
+    std::vector<Corner> corners;  // Three per triangle
+    size_t droppedTriangles = 0;
+    bool hasTexCoords = false;
+    bool hasNormals = false;
+};
+
+inline bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline const char* skipBlanks(const char* p, const char* end) {
+    while (p < end && isBlank(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+inline const char* findLineEnd(const char* p, const char* end) {
+    const void* newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+    return newline ? static_cast<const char*>(newline) : end;
+}
+
+// Advances p past the keyword of a line already stripped of leading blanks
+ObjLine classifyLine(const char*& p, const char* end) {
+    if (end - p < 2) {
+        return ObjLine::Other;
+    }
+    if (p[0] == 'v') {
+        if (isBlank(p[1])) {
+            p += 1;
+            return ObjLine::Position;
+        }
+        if (end - p >= 3 && isBlank(p[2])) {
+            ObjLine type = p[1] == 't' ? ObjLine::TexCoord : p[1] == 'n' ? ObjLine::Normal : ObjLine::Other;
+            p += 2;
+            return type;
+        }
+    } else if (p[0] == 'f' && isBlank(p[1])) {
+        p += 1;
+        return ObjLine::Face;
+    }
+    return ObjLine::Other;
+}
+
+// Reads up to count floats; missing or malformed ones stay zero
+void parseFloats(const char* p, const char* end, float* out, int count) {
+    for (int i = 0; i < count; ++i) {
+        out[i] = 0.0f;
+    }
+    for (int i = 0; i < count; ++i) {
+        p = skipBlanks(p, end);
+        if (p < end && *p == '+') {
+            ++p;
+        }
+        std::from_chars_result result = std::from_chars(p, end, out[i]);
+        if (result.ec != std::errc()) {
+            out[i] = 0.0f;
+            return;
+        }
+        p = result.ptr;
+    }
+}
+
+// OBJ indices are 1-based, or relative to the attributes read so far when negative
+inline uint32_t resolveIndex(long long index, size_t readSoFar, size_t total) {
+    long long resolved = index > 0 ? index - 1 : static_cast<long long>(readSoFar) + index;
+    return index != 0 && resolved >= 0 && resolved < static_cast<long long>(total) ? static_cast<uint32_t>(resolved)
+                                                                                   : BAD_INDEX;
+}
+
+void countObjChunk(ObjChunk& chunk) {
+    for (const char* p = chunk.begin; p < chunk.end;) {
+        const char* lineEnd = findLineEnd(p, chunk.end);
+        const char* q = skipBlanks(p, lineEnd);
+        switch (classifyLine(q, lineEnd)) {
+        case ObjLine::Position: ++chunk.positionCount; break;
+        case ObjLine::TexCoord: ++chunk.texCoordCount; break;
+        case ObjLine::Normal: ++chunk.normalCount; break;
+        default: break;
+        }
+        p = lineEnd + 1;
+    }
+}
+
+void parseObjChunk(ObjChunk& chunk, float* positions, float* texCoords, float* normals, size_t positionTotal,
+                   size_t texCoordTotal, size_t normalTotal) {
+    size_t position = chunk.positionBase;
+    size_t texCoord = chunk.texCoordBase;
+    size_t normal = chunk.normalBase;
+    std::vector<Corner> face;
+
+    for (const char* p = chunk.begin; p < chunk.end;) {
+        const char* lineEnd = findLineEnd(p, chunk.end);
+        const char* q = skipBlanks(p, lineEnd);
+        switch (classifyLine(q, lineEnd)) {
+        case ObjLine::Position:
+            parseFloats(q, lineEnd, positions + 3 * position++, 3);
+            break;
+        case ObjLine::TexCoord:
+            parseFloats(q, lineEnd, texCoords + 2 * texCoord++, 2);
+            break;
+        case ObjLine::Normal:
+            parseFloats(q, lineEnd, normals + 3 * normal++, 3);
+            break;
+        case ObjLine::Face: {
+            face.clear();
+            bool valid = true;
+            while (true) {
+                q = skipBlanks(q, lineEnd);
+                if (q >= lineEnd) {
+                    break;
+                }
+                long long indices[3] = {0, 0, 0};
+                bool present[3] = {false, false, false};
+                for (int slot = 0; slot < 3; ++slot) {
+                    std::from_chars_result result = std::from_chars(q, lineEnd, indices[slot]);
+                    present[slot] = result.ec == std::errc();
+                    q = result.ptr;
+                    if (q >= lineEnd || *q != '/') {
+                        break;
+                    }
+                    ++q;
+                }
+                // Skip whatever is left of a malformed token
+                while (q < lineEnd && !isBlank(*q)) {
+                    ++q;
+                    present[0] = false;
+                }
+                Corner corner;
+                corner.position = present[0] ? resolveIndex(indices[0], position, positionTotal) : BAD_INDEX;
+                corner.texCoord = present[1] ? resolveIndex(indices[1], texCoord, texCoordTotal) : NO_INDEX;
+                corner.normal = present[2] ? resolveIndex(indices[2], normal, normalTotal) : NO_INDEX;
+                valid = valid && corner.position != BAD_INDEX && corner.texCoord != BAD_INDEX &&
+                        corner.normal != BAD_INDEX;
+                chunk.hasTexCoords = chunk.hasTexCoords || corner.texCoord != NO_INDEX;
+                chunk.hasNormals = chunk.hasNormals || corner.normal != NO_INDEX;
+                face.push_back(corner);
+            }
+            if (face.size() < 3) {
+                break;
+            }
+            if (!valid) {
+                chunk.droppedTriangles += face.size() - 2;
+                break;
+            }
+            for (size_t i = 1; i + 1 < face.size(); ++i) {
+                chunk.corners.push_back(face[0]);
+                chunk.corners.push_back(face[i]);
+                chunk.corners.push_back(face[i + 1]);
+            }
+            break;
+        }
+        default:
+            break;
+        }
+        p = lineEnd + 1;
+    }
+}
+
+// --- glTF ---
+
+constexpr uint32_t GLB_MAGIC = 0x46546C67;       // "glTF"
+constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;  // "JSON"
+constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;   // "BIN\0"
+constexpr int GLTF_MODE_TRIANGLES = 4;
+
+struct GltfBuffer {
+    MappedFile file;
+    std::vector<uint8_t> owned;
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+};
+
+struct Accessor {
+    const uint8_t* data = nullptr;
+    size_t count = 0;
+    size_t stride = 0;
+    int componentType = 0;
+    int components = 0;
+    bool normalized = false;
+};
+
+size_t componentSize(int componentType) {
+    switch (componentType) {
+    case 5120: case 5121: return 1;  // (U)BYTE
+    case 5122: case 5123: return 2;  // (U)SHORT
+    case 5125: case 5126: return 4;  // UINT, FLOAT
+    default: return 0;
+    }
+}
+
+// object[key], or an empty value when missing, without copying like json::value would
+const json& member(const json& object, const char* key) {
+    static const json empty;
+    auto it = object.find(key);
+    return it != object.end() ? *it : empty;
+}
+
+int componentCount(const std::string& type) {
+    if (type == "SCALAR") return 1;
+    if (type == "VEC2") return 2;
+    if (type == "VEC3") return 3;
+    if (type == "VEC4") return 4;
+    return 0;
+}
+
+bool decodeBase64(std::string_view text, std::vector<uint8_t>& out) {
+    static const auto table = [] {
+        std::array<int8_t, 256> values{};
+        values.fill(-1);
+        const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (int i = 0; i < 64; ++i) {
+            values[static_cast<unsigned char>(alphabet[i])] = static_cast<int8_t>(i);
+        }
+        return values;
+    }();
+
+    out.clear();
+    out.reserve(text.size() / 4 * 3);
+    uint32_t bits = 0;
+    int bitCount = 0;
+    for (char c : text) {
+        if (c == '=') {
+            break;
+        }
+        int8_t value = table[static_cast<unsigned char>(c)];
+        if (value < 0) {
+            return false;
+        }
+        bits = (bits << 6) | static_cast<uint32_t>(value);
+        bitCount += 6;
+        if (bitCount >= 8) {
+            bitCount -= 8;
+            out.push_back(static_cast<uint8_t>(bits >> bitCount));
+        }
+    }
+    return true;
+}
+
+bool loadAccessor(const json& document, const std::vector<GltfBuffer>& buffers, size_t index, Accessor& out) {
+    const json& accessors = member(document, "accessors");
+    if (index >= accessors.size()) {
+        return false;
+    }
+    const json& accessor = accessors[index];
+    if (accessor.contains("sparse") || !accessor.contains("bufferView")) {
+        return false;  // Sparse and all-zero accessors are not supported
+    }
+    const json& bufferViews = member(document, "bufferViews");
+    size_t viewIndex = accessor["bufferView"].get<size_t>();
+    if (viewIndex >= bufferViews.size()) {
+        return false;
+    }
+    const json& view = bufferViews[viewIndex];
+    size_t bufferIndex = view.value("buffer", size_t(0));
+    if (bufferIndex >= buffers.size()) {
+        return false;
+    }
+
+    out.componentType = accessor.value("componentType", 0);
+    out.components = componentCount(accessor.value("type", std::string()));
+    out.normalized = accessor.value("normalized", false);
+    out.count = accessor.value("count", size_t(0));
+    size_t elementSize = componentSize(out.componentType) * out.components;
+    out.stride = view.value("byteStride", elementSize);
+    size_t viewOffset = view.value("byteOffset", size_t(0));
+    size_t viewLength = view.value("byteLength", size_t(0));
+    size_t offset = accessor.value("byteOffset", size_t(0));
+    const GltfBuffer& buffer = buffers[bufferIndex];
+    if (elementSize == 0 || out.stride < elementSize || viewOffset > buffer.size ||
+        viewLength > buffer.size - viewOffset ||
+        (out.count > 0 && (offset > viewLength || (out.count - 1) * out.stride + elementSize > viewLength - offset))) {
+        return false;
+    }
+    out.data = buffer.data + viewOffset + offset;
+    return true;
+}
+
+float readComponent(const Accessor& accessor, size_t element, int component) {
+    const uint8_t* p = accessor.data + element * accessor.stride + component * componentSize(accessor.componentType);
+    switch (accessor.componentType) {
+    case 5126: { float v; std::memcpy(&v, p, sizeof(v)); return v; }
+    case 5121: return accessor.normalized ? *p / 255.0f : *p;
+    case 5120: { int8_t v = static_cast<int8_t>(*p); return accessor.normalized ? std::max(v / 127.0f, -1.0f) : v; }
+    case 5123: { uint16_t v; std::memcpy(&v, p, sizeof(v)); return accessor.normalized ? v / 65535.0f : v; }
+    case 5122: { int16_t v; std::memcpy(&v, p, sizeof(v)); return accessor.normalized ? std::max(v / 32767.0f, -1.0f) : v; }
+    default: return 0.0f;
+    }
+}
+
+uint32_t readIndex(const Accessor& accessor, size_t element) {
+    const uint8_t* p = accessor.data + element * accessor.stride;
+    switch (accessor.componentType) {
+    case 5121: return *p;
+    case 5123: { uint16_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+    case 5125: { uint32_t v; std::memcpy(&v, p, sizeof(v)); return v; }
+    default: return NO_INDEX;
+    }
+}
+
+// Maps the .gltf/.glb file and every buffer it references
+bool loadGltfDocument(const std::string& path, MappedFile& file, json& document, std::vector<GltfBuffer>& buffers,
+                      size_t& bytes) {
+    if (!file.open(path, AccessHint::Sequential)) {
+        return false;
+    }
+    bytes = file.size();
+
+    std::string_view text = file.view();
+    std::string_view binaryChunk;
+    if (file.size() >= 12 && std::memcmp(file.data(), &GLB_MAGIC, sizeof(GLB_MAGIC)) == 0) {
+        // Header (magic, version, length), then length-prefixed JSON and BIN chunks
+        text = {};
+        size_t offset = 12;
+        while (offset + 8 <= file.size()) {
+            uint32_t chunkLength;
+            uint32_t chunkType;
+            std::memcpy(&chunkLength, file.data() + offset, sizeof(chunkLength));
+            std::memcpy(&chunkType, file.data() + offset + 4, sizeof(chunkType));
+            offset += 8;
+            if (chunkLength > file.size() - offset) {
+                return false;
+            }
+            if (chunkType == GLB_CHUNK_JSON) {
+                text = file.view(offset, chunkLength);
+            } else if (chunkType == GLB_CHUNK_BIN && binaryChunk.empty()) {
+                binaryChunk = file.view(offset, chunkLength);
+            }
+            offset += (chunkLength + 3) & ~size_t(3);
+        }
+    }
+
+    document = json::parse(text.begin(), text.end(), nullptr, false);
+    if (document.is_discarded() || !document.is_object()) {
+        return false;
+    }
+
+    std::filesystem::path directory = std::filesystem::path(path).parent_path();
+    const json& bufferList = member(document, "buffers");
+    buffers = std::vector<GltfBuffer>(bufferList.size());
+    for (size_t i = 0; i < bufferList.size(); ++i) {
+        GltfBuffer& buffer = buffers[i];
+        std::string uri = bufferList[i].value("uri", std::string());
+        if (uri.empty()) {
+            buffer.data = reinterpret_cast<const uint8_t*>(binaryChunk.data());
+            buffer.size = binaryChunk.size();
+        } else if (uri.compare(0, 5, "data:") == 0) {
+            size_t comma = uri.find(',');
+            if (comma == std::string::npos || !decodeBase64(std::string_view(uri).substr(comma + 1), buffer.owned)) {
+                return false;
+            }
+            buffer.data = buffer.owned.data();
+            buffer.size = buffer.owned.size();
+        } else {
+            if (!buffer.file.open((directory / uri).string(), AccessHint::Sequential)) {
+                return false;
+            }
+            buffer.data = buffer.file.data();
+            buffer.size = buffer.file.size();
+            bytes += buffer.size;
+        }
+    }
+    return true;
+}
+
+// Appends one triangle-list primitive to vertices/triangles; false when its
+// accessors cannot be read
+bool appendPrimitive(const json& document, const std::vector<GltfBuffer>& buffers, const json& primitive,
+                     std::vector<Vertex>& vertices, std::vector<Triangle>& triangles, ThreadPool& pool,
+                     size_t& droppedTriangles) {
+    const json& attributes = member(primitive, "attributes");
+    Accessor positions;
+    if (!attributes.is_object() || !attributes.contains("POSITION") ||
+        !loadAccessor(document, buffers, attributes["POSITION"].get<size_t>(), positions) ||
+        positions.componentType != 5126 || positions.components != 3) {
+        return false;
+    }
+    Accessor normals;
+    bool hasNormals = attributes.contains("NORMAL") &&
+                      loadAccessor(document, buffers, attributes["NORMAL"].get<size_t>(), normals) &&
+                      normals.components == 3 && normals.count == positions.count;
+    Accessor texCoords;
+    bool hasTexCoords = attributes.contains("TEXCOORD_0") &&
+                        loadAccessor(document, buffers, attributes["TEXCOORD_0"].get<size_t>(), texCoords) &&
+                        texCoords.components == 2 && texCoords.count == positions.count;
+    Accessor indices;
+    bool indexed = primitive.contains("indices");
+    if (indexed && (!loadAccessor(document, buffers, primitive["indices"].get<size_t>(), indices) ||
+                    indices.components != 1 ||
+                    (indices.componentType != 5121 && indices.componentType != 5123 &&
+                     indices.componentType != 5125))) {
+        return false;
+    }
+
+    size_t firstVertex = vertices.size();
+    size_t firstTriangle = triangles.size();
+    size_t vertexCount = positions.count;
+    size_t triangleCount = (indexed ? indices.count : vertexCount) / 3;
+    vertices.resize(firstVertex + vertexCount);
+    triangles.resize(firstTriangle + triangleCount);
+
+    pool.parallelFor(vertexCount, MIN_VERTEX_SHARE, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            Vertex& vertex = vertices[firstVertex + i];
+            vertex.position = Vector(readComponent(positions, i, 0), readComponent(positions, i, 1),
+                                     readComponent(positions, i, 2));
+            vertex.normal = hasNormals ? Vector(readComponent(normals, i, 0), readComponent(normals, i, 1),
+                                                readComponent(normals, i, 2))
+                                       : Vector();
+            vertex.texCoord = hasTexCoords ? Vector(readComponent(texCoords, i, 0), readComponent(texCoords, i, 1), 0)
+                                           : Vector();
+        }
+    });
+
+    std::atomic<size_t> dropped{0};
+    pool.parallelFor(triangleCount, MIN_VERTEX_SHARE, [&](size_t begin, size_t end) {
+        size_t localDropped = 0;
+        for (size_t i = begin; i < end; ++i) {
+            uint32_t corner[3];
+            for (int c = 0; c < 3; ++c) {
+                corner[c] = indexed ? readIndex(indices, 3 * i + c) : static_cast<uint32_t>(3 * i + c);
+            }
+            if (corner[0] >= vertexCount || corner[1] >= vertexCount || corner[2] >= vertexCount) {
+                triangles[firstTriangle + i] = {-1, -1, -1};
+                ++localDropped;
+                continue;
+            }
+            triangles[firstTriangle + i] = {static_cast<int>(firstVertex + corner[0]),
+                                            static_cast<int>(firstVertex + corner[1]),
+                                            static_cast<int>(firstVertex + corner[2])};
+        }
+        dropped += localDropped;
+    });
+    if (dropped > 0) {
+        triangles.erase(std::remove_if(triangles.begin() + firstTriangle, triangles.end(),
+                                       [](const Triangle& t) { return t.v1 < 0; }),
+                        triangles.end());
+        droppedTriangles += dropped;
+    }
+
+    if (!hasNormals) {
+        computeMissingNormals(vertices, triangles, firstVertex, firstTriangle);
+    }
+    return true;
+}
+}
+
+bool MeshImporter::importFile(const std::string& path, std::vector<Mesh>& meshes, ImportStats* stats) {
+    return importFile(path, meshes, ThreadPool::getIOPool(), stats);
+}
+
+bool MeshImporter::importFile(const std::string& path, std::vector<Mesh>& meshes, ThreadPool& pool,
+                              ImportStats* stats) {
+    std::string extension = lowerExtension(path);
+    ImportStats fileStats;
+    if (extension == ".gltf" || extension == ".glb") {
+        if (!importGltf(path, meshes, pool, &fileStats)) {
+            return false;
+        }
+    } else if (extension == ".obj") {
+        MappedFile file;
+        if (!file.open(path, AccessHint::Sequential)) {
+            LOG_ERROR("Failed to open mesh: " + path);
+            return false;
+        }
+        Mesh mesh;
+        if (!importObj(file.view(), std::filesystem::path(path).stem().string(), mesh, pool, &fileStats)) {
+            LOG_ERROR("Failed to import mesh: " + path);
+            return false;
+        }
+        meshes.push_back(std::move(mesh));
+    } else {
+        LOG_ERROR("Unsupported mesh format: " + path);
+        return false;
+    }
+
+    LOG_INFO("Imported " + path + ": " + std::to_string(fileStats.vertices) + " vertices, " +
+             std::to_string(fileStats.triangles) + " triangles, " + std::to_string(fileStats.bytes >> 10) +
+             " KB in " + std::to_string(static_cast<int>(fileStats.parseMs + fileStats.buildMs)) + " ms (" +
+             std::to_string(static_cast<int>(fileStats.throughputMBps())) + " MB/s)");
+    if (stats) {
+        stats->bytes += fileStats.bytes;
+        stats->vertices += fileStats.vertices;
+        stats->triangles += fileStats.triangles;
+        stats->droppedTriangles += fileStats.droppedTriangles;
+        stats->parseMs += fileStats.parseMs;
+        stats->buildMs += fileStats.buildMs;
+    }
+    return true;
+}
+
+bool MeshImporter::importCooked(const std::string& path, std::vector<CookedMesh>& cooked, ThreadPool& pool,
+                                ImportStats* stats) {
+    std::vector<Mesh> meshes;
+    if (!importFile(path, meshes, pool, stats)) {
+        return false;
+    }
+    size_t first = cooked.size();
+    cooked.resize(first + meshes.size());
+    pool.parallelFor(meshes.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            cooked[first + i] = MeshCooker::cook(meshes[i]);
+            meshes[i] = Mesh();
+        }
+    });
+    return true;
+}
+
+bool MeshImporter::importObj(std::string_view text, const std::string& name, Mesh& mesh, ThreadPool& pool,
+                             ImportStats* stats) {
+    PROFILE_SCOPE_CATEGORY("MeshImporter::importObj", "io");
+    Clock::time_point start = Clock::now();
+
+    // Chunks end on line boundaries, one per worker plus the calling thread
+    size_t chunkCount = std::max<size_t>(1, std::min(pool.getThreadCount() + 1, text.size() / MIN_CHUNK_BYTES));
+    std::vector<ObjChunk> chunks(chunkCount);
+    const char* cursor = text.data();
+    const char* textEnd = text.data() + text.size();
+    for (size_t i = 0; i < chunkCount; ++i) {
+        const char* end = i + 1 == chunkCount ? textEnd : text.data() + text.size() * (i + 1) / chunkCount;
+        if (end < textEnd) {
+            end = std::min(textEnd, findLineEnd(std::max(end, cursor), textEnd) + 1);
+        }
+        chunks[i].begin = cursor;
+        chunks[i].end = std::max(end, cursor);
+        cursor = chunks[i].end;
+    }
+
+    pool.parallelFor(chunkCount, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            countObjChunk(chunks[i]);
+        }
+    });
+
+    size_t positionTotal = 0;
+    size_t texCoordTotal = 0;
+    size_t normalTotal = 0;
+    for (ObjChunk& chunk : chunks) {
+        chunk.positionBase = positionTotal;
+        chunk.texCoordBase = texCoordTotal;
+        chunk.normalBase = normalTotal;
+        positionTotal += chunk.positionCount;
+        texCoordTotal += chunk.texCoordCount;
+        normalTotal += chunk.normalCount;
+    }
+    if (positionTotal >= BAD_INDEX || texCoordTotal >= BAD_INDEX || normalTotal >= BAD_INDEX) {
+        return false;
+    }
+
+    std::vector<float> positions(3 * positionTotal);
+    std::vector<float> texCoords(2 * texCoordTotal);
+    std::vector<float> normals(3 * normalTotal);
+    pool.parallelFor(chunkCount, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            parseObjChunk(chunks[i], positions.data(), texCoords.data(), normals.data(), positionTotal,
+                          texCoordTotal, normalTotal);
+        }
+    });
+    double parseMs = elapsedMs(start);
+    start = Clock::now();
+
+    // Merge v/vt/vn corners into vertices; position-only files map one to one
+    size_t cornerTotal = 0;
+    size_t droppedTriangles = 0;
+    bool mergeCorners = false;
+    for (const ObjChunk& chunk : chunks) {
+        cornerTotal += chunk.corners.size();
+        droppedTriangles += chunk.droppedTriangles;
+        mergeCorners = mergeCorners || chunk.hasTexCoords || chunk.hasNormals;
+    }
+    if (cornerTotal == 0) {
+        LOG_ERROR("No triangles in OBJ " + name);
+        return false;
+    }
+    std::vector<Corner> unique;
+    std::vector<Triangle> triangles(cornerTotal / 3);
+    if (mergeCorners) {
+        std::unordered_map<Corner, uint32_t, CornerHash> lookup;
+        lookup.reserve(positionTotal + positionTotal / 2);
+        size_t corner = 0;
+        for (const ObjChunk& chunk : chunks) {
+            for (const Corner& c : chunk.corners) {
+                auto inserted = lookup.emplace(c, static_cast<uint32_t>(unique.size()));
+                if (inserted.second) {
+                    unique.push_back(c);
+                }
+                int index = static_cast<int>(inserted.first->second);
+                Triangle& triangle = triangles[corner / 3];
+                (corner % 3 == 0 ? triangle.v1 : corner % 3 == 1 ? triangle.v2 : triangle.v3) = index;
+                ++corner;
+            }
+        }
+    } else {
+        size_t corner = 0;
+        for (const ObjChunk& chunk : chunks) {
+            for (size_t i = 0; i < chunk.corners.size(); i += 3, ++corner) {
+                triangles[corner] = {static_cast<int>(chunk.corners[i].position),
+                                     static_cast<int>(chunk.corners[i + 1].position),
+                                     static_cast<int>(chunk.corners[i + 2].position)};
+            }
+        }
+    }
+    chunks.clear();
+
+    size_t vertexCount = mergeCorners ? unique.size() : positionTotal;
+    std::vector<Vertex> vertices(vertexCount);
+    pool.parallelFor(vertexCount, MIN_VERTEX_SHARE, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            Corner c = mergeCorners ? unique[i] : Corner{static_cast<uint32_t>(i), NO_INDEX, NO_INDEX};
+            const float* p = &positions[3 * c.position];
+            Vertex& vertex = vertices[i];
+            vertex.position = Vector(p[0], p[1], p[2]);
+            if (c.normal != NO_INDEX) {
+                const float* n = &normals[3 * c.normal];
+                vertex.normal = Vector(n[0], n[1], n[2]).normalize();
+            }
+            if (c.texCoord != NO_INDEX) {
+                vertex.texCoord = Vector(texCoords[2 * c.texCoord], texCoords[2 * c.texCoord + 1], 0);
+            }
+        }
+    });
+    computeMissingNormals(vertices, triangles, 0, 0);
+
+    mesh = Mesh();
+    mesh.setName(name);
+    mesh.setGeometry(std::move(vertices), std::move(triangles));
+    double buildMs = elapsedMs(start);
+
+    if (stats) {
+        stats->bytes += text.size();
+        stats->vertices += mesh.getVertices().size();
+        stats->triangles += mesh.getTriangles().size();
+        stats->droppedTriangles += droppedTriangles;
+        stats->parseMs += parseMs;
+        stats->buildMs += buildMs;
+    }
+    if (droppedTriangles > 0) {
+        LOG_WARNING("Dropped " + std::to_string(droppedTriangles) + " OBJ triangles with invalid indices in " + name);
+    }
+    return true;
+}
+
+bool MeshImporter::importGltf(const std::string& path, std::vector<Mesh>& meshes, ThreadPool& pool,
+                              ImportStats* stats) {
+    PROFILE_SCOPE_CATEGORY("MeshImporter::importGltf", "io");
+    Clock::time_point start = Clock::now();
+
+    MappedFile file;
+    json document;
+    std::vector<GltfBuffer> buffers;
+    size_t bytes = 0;
+    size_t firstMesh = meshes.size();
+    size_t vertexCount = 0;
+    size_t triangleCount = 0;
+    size_t droppedTriangles = 0;
+    double parseMs = 0.0;
+    // Fields of the wrong JSON type throw json::type_error from get() and value()
+    try {
+        if (!loadGltfDocument(path, file, document, buffers, bytes)) {
+            LOG_ERROR("Failed to load glTF: " + path);
+            return false;
+        }
+        parseMs = elapsedMs(start);
+        start = Clock::now();
+
+        const json& meshList = member(document, "meshes");
+        std::string stem = std::filesystem::path(path).stem().string();
+        for (size_t m = 0; m < meshList.size(); ++m) {
+            std::vector<Vertex> vertices;
+            std::vector<Triangle> triangles;
+            for (const json& primitive : member(meshList[m], "primitives")) {
+                if (primitive.value("mode", GLTF_MODE_TRIANGLES) != GLTF_MODE_TRIANGLES) {
+                    continue;
+                }
+                if (!appendPrimitive(document, buffers, primitive, vertices, triangles, pool, droppedTriangles)) {
+                    LOG_WARNING("Skipped unreadable glTF primitive in mesh " + std::to_string(m) + " of " + path);
+                }
+            }
+            if (triangles.empty()) {
+                continue;
+            }
+            Mesh mesh;
+            mesh.setName(meshList[m].value("name", stem + "_" + std::to_string(m)));
+            vertexCount += vertices.size();
+            triangleCount += triangles.size();
+            mesh.setGeometry(std::move(vertices), std::move(triangles));
+            meshes.push_back(std::move(mesh));
+        }
+    } catch (const json::exception& e) {
+        meshes.resize(firstMesh);
+        LOG_ERROR("Malformed glTF " + path + ": " + e.what());
+        return false;
+    }
+    double buildMs = elapsedMs(start);
+
+    if (stats) {
+        stats->bytes += bytes;
+        stats->vertices += vertexCount;
+        stats->triangles += triangleCount;
+        stats->droppedTriangles += droppedTriangles;
+        stats->parseMs += parseMs;
+        stats->buildMs += buildMs;
+    }
+    if (triangleCount == 0) {
+        LOG_ERROR("No triangle meshes in glTF: " + path);
+        return false;
+    }
+    return true;
+}
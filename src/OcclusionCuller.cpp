@@ -0,0 +1,210 @@
+#include "OcclusionCuller.h"
+#include "EngineBackend.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OCCLUSION_SSE 1
+#endif
+
+namespace {
+constexpr float FAR_DEPTH = std::numeric_limits<float>::infinity();
+constexpr float OCCLUDER_DISC_SCALE = 0.7f;
+constexpr int RASTER_ROWS_PER_SHARE = 16;
+}
+
+OcclusionCuller::OcclusionCuller() : viewMatrix(1.0f), scaleX(0.0f), scaleY(0.0f) {
+    for (int width = WIDTH, height = HEIGHT; ; width = std::max(1, width / 2), height = std::max(1, height / 2)) {
+        levels.push_back(Level{width, height, std::vector<float>(static_cast<size_t>(width) * height, FAR_DEPTH)});
+        if (width == 1 && height == 1) {
+            break;
+        }
+    }
+}
+
+OcclusionCuller::ViewSphere OcclusionCuller::toView(const SphereArrays& spheres, size_t i) const {
+    glm::vec4 center = viewMatrix * glm::vec4(spheres.x[i], spheres.y[i], spheres.z[i], 1.0f);
+    return ViewSphere{glm::vec3(center.x, center.y, -center.z), spheres.radius[i]};
+}
+
+void OcclusionCuller::build(const glm::mat4& view, const glm::mat4& projection, const SphereArrays& spheres,
+                            const uint8_t* visible, ThreadPool& pool) {
+    PROFILE_SCOPE_CATEGORY("OcclusionCuller::build", "render");
+    viewMatrix = view;
+    // Symmetric perspective only: ndc = projection[0][0] * x / z
+    scaleX = projection[0][0] * 0.5f * WIDTH;
+    scaleY = projection[1][1] * 0.5f * HEIGHT;
+
+    // Occluders: the visible spheres with the largest projected radius
+    candidates.clear();
+    for (size_t i = 0; i < spheres.size(); ++i) {
+        if (!visible[i]) {
+            continue;
+        }
+        ViewSphere sphere = toView(spheres, i);
+        if (sphere.center.z - sphere.radius <= 0.0f) {
+            continue;  // Reaches behind the camera
+        }
+        float projected = sphere.radius * scaleY / sphere.center.z;
+        if (projected >= MIN_OCCLUDER_PIXELS) {
+            candidates.emplace_back(projected, i);
+        }
+    }
+    size_t occluderCount = std::min(candidates.size(), MAX_OCCLUDERS);
+    std::partial_sort(candidates.begin(), candidates.begin() + occluderCount, candidates.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    occluders.clear();
+    for (size_t c = 0; c < occluderCount; ++c) {
+        ViewSphere sphere = toView(spheres, candidates[c].second);
+        float invZ = 1.0f / sphere.center.z;
+        occluders.push_back(Occluder{
+            (sphere.center.x * invZ * scaleX) + 0.5f * WIDTH,
+            (sphere.center.y * invZ * scaleY) + 0.5f * HEIGHT,
+            OCCLUDER_DISC_SCALE * sphere.radius * invZ * scaleX,
+            OCCLUDER_DISC_SCALE * sphere.radius * invZ * scaleY,
+            sphere.center.z});
+    }
+
+    // Bands of rows rasterize independently; the pyramid above them is small
+    pool.parallelFor(HEIGHT, RASTER_ROWS_PER_SHARE, [this](size_t begin, size_t end) {
+        rasterize(static_cast<int>(begin), static_cast<int>(end));
+    });
+    for (size_t level = 1; level < levels.size(); ++level) {
+        buildLevel(level);
+    }
+}
+
+void OcclusionCuller::rasterize(int firstRow, int lastRow) {
+    std::vector<float>& depth = levels[0].depth;
+    std::fill(depth.begin() + static_cast<size_t>(firstRow) * WIDTH,
+              depth.begin() + static_cast<size_t>(lastRow) * WIDTH, FAR_DEPTH);
+
+    for (const Occluder& occluder : occluders) {
+        int top = std::max(firstRow, static_cast<int>(std::ceil(occluder.y - occluder.ry - 0.5f)));
+        int bottom = std::min(lastRow - 1, static_cast<int>(std::floor(occluder.y + occluder.ry - 0.5f)));
+        for (int y = top; y <= bottom; ++y) {
+            // Span of pixel centers inside the disc on this row
+            float dy = (y + 0.5f - occluder.y) / occluder.ry;
+            if (dy * dy >= 1.0f) {
+                continue;
+            }
+            float half = occluder.rx * std::sqrt(1.0f - dy * dy);
+            int x = std::max(0, static_cast<int>(std::ceil(occluder.x - half - 0.5f)));
+            int end = std::min(WIDTH, static_cast<int>(std::floor(occluder.x + half - 0.5f)) + 1);
+            float* row = depth.data() + static_cast<size_t>(y) * WIDTH;
+#ifdef OCCLUSION_SSE
+            __m128 occluderDepth = _mm_set1_ps(occluder.depth);
+            for (; x + 4 <= end; x += 4) {
+                _mm_storeu_ps(row + x, _mm_min_ps(_mm_loadu_ps(row + x), occluderDepth));
+            }
+#endif
+            for (; x < end; ++x) {
+                row[x] = std::min(row[x], occluder.depth);
+            }
+        }
+    }
+}
+
+void OcclusionCuller::buildLevel(size_t level) {
+    const Level& source = levels[level - 1];
+    Level& target = levels[level];
+    for (int y = 0; y < target.height; ++y) {
+        // Odd sizes never occur (powers of two), but a 1-high source repeats its row
+        const float* rowA = source.depth.data() + static_cast<size_t>(std::min(2 * y, source.height - 1)) * source.width;
+        const float* rowB = source.depth.data() + static_cast<size_t>(std::min(2 * y + 1, source.height - 1)) * source.width;
+        float* out = target.depth.data() + static_cast<size_t>(y) * target.width;
+        int x = 0;
+        if (source.width == 2 * target.width) {
+#ifdef OCCLUSION_SSE
+            // Eight source texels per row pair become four
+            for (; x + 4 <= target.width; x += 4) {
+                __m128 low = _mm_max_ps(_mm_loadu_ps(rowA + 2 * x), _mm_loadu_ps(rowB + 2 * x));
+                __m128 high = _mm_max_ps(_mm_loadu_ps(rowA + 2 * x + 4), _mm_loadu_ps(rowB + 2 * x + 4));
+                __m128 even = _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0));
+                __m128 odd = _mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1));
+                _mm_storeu_ps(out + x, _mm_max_ps(even, odd));
+            }
+#endif
+            for (; x < target.width; ++x) {
+                out[x] = std::max(std::max(rowA[2 * x], rowA[2 * x + 1]), std::max(rowB[2 * x], rowB[2 * x + 1]));
+            }
+        } else {
+            for (; x < target.width; ++x) {
+                out[x] = std::max(rowA[x], rowB[x]);
+            }
+        }
+    }
+}
+
+bool OcclusionCuller::isOccluded(const ViewSphere& sphere) const {
+    float z = sphere.center.z;
+    float r = sphere.radius;
+    if (z - r <= 0.0f) {
+        return false;  // Reaches behind the camera
+    }
+
+    // Exact screen bounds of the projected sphere from its tangent lines, per axis
+    float bounds[2][2];
+    const float centers[2] = {sphere.center.x, sphere.center.y};
+    const float scales[2] = {scaleX, scaleY};
+    for (int axis = 0; axis < 2; ++axis) {
+        float c = centers[axis];
+        float t = std::sqrt(c * c + z * z - r * r);
+        float low = (c * t - r * z) / (z * t + r * c);
+        float high = (c * t + r * z) / (z * t - r * c);
+        bounds[axis][0] = low * scales[axis];
+        bounds[axis][1] = high * scales[axis];
+    }
+    int x0 = static_cast<int>(std::floor(bounds[0][0] + 0.5f * WIDTH));
+    int x1 = static_cast<int>(std::floor(bounds[0][1] + 0.5f * WIDTH));
+    int y0 = static_cast<int>(std::floor(bounds[1][0] + 0.5f * HEIGHT));
+    int y1 = static_cast<int>(std::floor(bounds[1][1] + 0.5f * HEIGHT));
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, WIDTH - 1);
+    y1 = std::min(y1, HEIGHT - 1);
+    if (x0 > x1 || y0 > y1) {
+        return false;  // Off screen; frustum culling's call
+    }
+
+    // Coarsest level at which the bounds span at most two texels per axis
+    size_t level = 0;
+    while (level + 1 < levels.size() && ((x1 >> level) - (x0 >> level) > 1 || (y1 >> level) - (y0 >> level) > 1)) {
+        ++level;
+    }
+    const Level& hiz = levels[level];
+    float farthest = 0.0f;
+    for (int y = y0 >> level; y <= (y1 >> level); ++y) {
+        for (int x = x0 >> level; x <= (x1 >> level); ++x) {
+            farthest = std::max(farthest, hiz.depth[static_cast<size_t>(y) * hiz.width + x]);
+        }
+    }
+    return z - r > farthest;
+}
+
+size_t OcclusionCuller::cull(const SphereArrays& spheres, size_t first, size_t last, uint8_t* visible) const {
+    size_t rejected = 0;
+    for (size_t i = first; i < last; ++i) {
+        if (visible[i] && isOccluded(toView(spheres, i))) {
+            visible[i] = 0;
+            rejected++;
+        }
+    }
+    return rejected;
+}
+
+size_t OcclusionCuller::cullParallel(const SphereArrays& spheres, uint8_t* visible, ThreadPool& pool) const {
+    if (occluders.empty()) {
+        return 0;
+    }
+    std::atomic<size_t> rejected{0};
+    pool.parallelFor(spheres.size(), Frustum::PARALLEL_THRESHOLD, [&](size_t begin, size_t end) {
+        rejected.fetch_add(cull(spheres, begin, end, visible), std::memory_order_relaxed);
+    });
+    return rejected.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,255 @@
+#include "PerfCounters.h"
+#include "EngineBackend.h"
+#include "EngineConfig.h"
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// PerfSample Implementation
+double PerfSample::getIPC() const {
+    if (!has(PerfCounter::Cycles) || !has(PerfCounter::Instructions) || get(PerfCounter::Cycles) == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(get(PerfCounter::Instructions)) / get(PerfCounter::Cycles);
+}
+
+PerfSample PerfSample::operator-(const PerfSample& earlier) const {
+    PerfSample result;
+    result.availableMask = availableMask & earlier.availableMask;
+    for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+        // Scaled values of a multiplexed group can step backwards slightly
+        result.values[i] = values[i] > earlier.values[i] ? values[i] - earlier.values[i] : 0;
+    }
+    return result;
+}
+
+PerfSample& PerfSample::operator+=(const PerfSample& other) {
+    availableMask = availableMask ? (availableMask & other.availableMask) : other.availableMask;
+    for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+        values[i] += other.values[i];
+    }
+    return *this;
+}
+
+// PerfCounters Implementation
+struct PerfCounters::ThreadCounters {
+    bool attempted = false;
+    int leaderFd = -1;
+    std::vector<int> fds;
+    std::vector<PerfCounter> order;  // Counter for each value in a group read
+    uint32_t availableMask = 0;
+
+    ~ThreadCounters() {
+#ifdef __linux__
+        for (int fd : fds) {
+            close(fd);
+        }
+#endif
+    }
+};
+
+namespace {
+#ifdef __linux__
+struct CounterConfig {
+    PerfCounter counter;
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr uint64_t cacheMissConfig(uint64_t cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+const CounterConfig COUNTER_CONFIGS[] = {
+    {PerfCounter::Cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PerfCounter::Instructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PerfCounter::L1DMisses, PERF_TYPE_HW_CACHE, cacheMissConfig(PERF_COUNT_HW_CACHE_L1D)},
+    {PerfCounter::LLCMisses, PERF_TYPE_HW_CACHE, cacheMissConfig(PERF_COUNT_HW_CACHE_LL)},
+    {PerfCounter::BranchMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+int openCounter(const CounterConfig& counter, int groupFd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = counter.type;
+    attr.config = counter.config;
+    attr.disabled = groupFd == -1 ? 1 : 0;  // The leader starts the whole group
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // Calling thread, any CPU
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+}
+#endif
+}
+
+PerfCounters& PerfCounters::getInstance() {
+    static PerfCounters instance;
+    return instance;
+}
+
+PerfCounters::PerfCounters()
+    : enabled(EngineConfig::getInstance().isHardwareCountersEnabled()),
+      unavailableLogged(false) {}
+
+PerfCounters::~PerfCounters() {}
+
+const char* PerfCounters::getCounterName(PerfCounter counter) {
+    switch (counter) {
+        case PerfCounter::Cycles: return "cycles";
+        case PerfCounter::Instructions: return "instructions";
+        case PerfCounter::L1DMisses: return "l1d_misses";
+        case PerfCounter::LLCMisses: return "llc_misses";
+        case PerfCounter::BranchMisses: return "branch_misses";
+        default: return "unknown";
+    }
+}
+
+PerfCounters::ThreadCounters& PerfCounters::localCounters() {
+    static thread_local ThreadCounters counters;
+    if (counters.attempted) {
+        return counters;
+    }
+    counters.attempted = true;
+
+#ifdef __linux__
+    int firstError = 0;
+    for (const CounterConfig& config : COUNTER_CONFIGS) {
+        int fd = openCounter(config, counters.leaderFd);
+        if (fd < 0) {
+            if (!firstError) firstError = errno;
+            continue;
+        }
+        if (counters.leaderFd == -1) {
+            counters.leaderFd = fd;
+        }
+        counters.fds.push_back(fd);
+        counters.order.push_back(config.counter);
+        counters.availableMask |= 1u << static_cast<unsigned>(config.counter);
+    }
+    if (counters.leaderFd != -1) {
+        ioctl(counters.leaderFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(counters.leaderFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+    if (firstError && !unavailableLogged.exchange(true)) {
+        LOG_WARNING(std::string("Some hardware counters are unavailable (") + std::strerror(firstError) +
+                    "); check /proc/sys/kernel/perf_event_paranoid");
+    }
+#else
+    if (!unavailableLogged.exchange(true)) {
+        LOG_WARNING("Hardware counters are only supported on Linux");
+    }
+#endif
+    return counters;
+}
+
+bool PerfCounters::read(PerfSample& sample) {
+    sample = PerfSample();
+    if (!isEnabled()) {
+        return false;
+    }
+    ThreadCounters& counters = localCounters();
+    if (counters.leaderFd == -1) {
+        return false;
+    }
+
+#ifdef __linux__
+    // PERF_FORMAT_GROUP layout: nr, time_enabled, time_running, value[nr]
+    uint64_t buffer[3 + PerfSample::COUNTER_COUNT];
+    ssize_t bytes = ::read(counters.leaderFd, buffer, sizeof(buffer));
+    if (bytes < static_cast<ssize_t>(3 * sizeof(uint64_t)) || buffer[0] != counters.order.size()) {
+        return false;
+    }
+    uint64_t timeEnabled = buffer[1];
+    uint64_t timeRunning = buffer[2];
+    if (timeRunning == 0) {
+        return false;
+    }
+    for (size_t i = 0; i < counters.order.size(); ++i) {
+        uint64_t value = buffer[3 + i];
+        if (timeRunning < timeEnabled) {
+            // The group shared the PMU with other events; extrapolate
+            value = static_cast<uint64_t>(static_cast<double>(value) * timeEnabled / timeRunning);
+        }
+        sample.values[static_cast<size_t>(counters.order[i])] = value;
+    }
+    sample.availableMask = counters.availableMask;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void PerfCounters::accumulate(const ProfileZone* zone, const PerfSample& delta) {
+    std::lock_guard<std::mutex> lock(countersMutex);
+    ZoneTotals& totals = zoneTotals[zone];
+    totals.zone = zone;
+    totals.calls++;
+    totals.totals += delta;
+}
+
+std::vector<PerfCounters::ZoneTotals> PerfCounters::getZoneTotals() const {
+    std::lock_guard<std::mutex> lock(countersMutex);
+    std::vector<ZoneTotals> result;
+    result.reserve(zoneTotals.size());
+    for (const auto& [zone, totals] : zoneTotals) {
+        result.push_back(totals);
+    }
+    return result;
+}
+
+std::string PerfCounters::getReport() const {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    for (const ZoneTotals& totals : getZoneTotals()) {
+        double calls = static_cast<double>(std::max<uint64_t>(totals.calls, 1));
+        ss << totals.zone->name << ": calls=" << totals.calls << " ipc=" << totals.totals.getIPC();
+        for (size_t i = 0; i < PerfSample::COUNTER_COUNT; ++i) {
+            PerfCounter counter = static_cast<PerfCounter>(i);
+            if (totals.totals.has(counter)) {
+                ss << " " << getCounterName(counter) << "/call=" << totals.totals.get(counter) / calls;
+            }
+        }
+        ss << "\n";
+    }
+    return ss.str();
+}
+
+void PerfCounters::resetZoneTotals() {
+    std::lock_guard<std::mutex> lock(countersMutex);
+    zoneTotals.clear();
+}
+
+// PerfCounterScope Implementation
+PerfCounterScope::PerfCounterScope(const ProfileZone* zone) : zone(zone) {
+    active = PerfCounters::getInstance().read(start);
+}
+
+PerfCounterScope::~PerfCounterScope() {
+    stop();
+}
+
+const PerfSample& PerfCounterScope::stop() {
+    if (!active) {
+        return delta;
+    }
+    active = false;
+    PerfSample end;
+    if (PerfCounters::getInstance().read(end)) {
+        delta = end - start;
+        if (zone) {
+            PerfCounters::getInstance().accumulate(zone, delta);
+        }
+    }
+    return delta;
+}
@@ -0,0 +1,167 @@
+#include "Profiler.h"
+#include "EngineBackend.h"
+#include "EngineConfig.h"
+#include <fstream>
+#include <iomanip>
+
+namespace {
+// Chrome trace strings are JSON; zone names are code identifiers but may carry quotes
+void writeEscaped(std::ofstream& out, const char* text) {
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << (static_cast<unsigned char>(*c) < 0x20 ? ' ' : *c);
+    }
+}
+}
+
+std::atomic<Profiler*> Profiler::constructed{nullptr};
+
+Profiler& Profiler::getInstance() {
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler() : enabled(EngineConfig::getInstance().isProfilingEnabled()) {
+    epoch();
+    constructed.store(this, std::memory_order_release);
+}
+
+Profiler::~Profiler() {
+    constructed.store(nullptr, std::memory_order_release);
+}
+
+std::chrono::steady_clock::time_point Profiler::epoch() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return start;
+}
+
+Profiler::ThreadBuffer& Profiler::localBuffer() {
+    // The registry keeps a reference too, so events outlive the thread that wrote them
+    static thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(profilerMutex);
+        buffer->index = static_cast<uint32_t>(threads.size());
+        buffer->name = "Thread " + std::to_string(buffer->index);
+        threads.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void Profiler::record(const ProfileZone* zone, uint64_t start, uint64_t end, uint32_t depth) {
+    ThreadBuffer& buffer = localBuffer();
+    uint64_t write = buffer.writePos.load(std::memory_order_relaxed);
+    if (write - buffer.readPos.load(std::memory_order_acquire) >= RING_CAPACITY) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer.events[write % RING_CAPACITY] = ProfileEvent{zone, start, end, depth, buffer.index};
+    buffer.writePos.store(write + 1, std::memory_order_release);
+}
+
+const ProfileZone* Profiler::internZone(const std::string& name, const char* category) {
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    for (const auto& [zoneName, zone] : internedZones) {
+        if (zoneName == name && zone.category == category) {
+            return &zone;
+        }
+    }
+    internedZones.emplace_back(name, ProfileZone{nullptr, category, "", 0});
+    auto& entry = internedZones.back();
+    entry.second.name = entry.first.c_str();
+    return &entry.second;
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = localBuffer();
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    buffer.name = name;
+}
+
+void Profiler::collectLocked() {
+    for (const auto& buffer : threads) {
+        uint64_t read = buffer->readPos.load(std::memory_order_relaxed);
+        uint64_t write = buffer->writePos.load(std::memory_order_acquire);
+        for (; read < write; ++read) {
+            history.push_back(buffer->events[read % RING_CAPACITY]);
+        }
+        buffer->readPos.store(read, std::memory_order_release);
+    }
+    while (history.size() > MAX_HISTORY) {
+        history.pop_front();
+    }
+}
+
+void Profiler::collect() {
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    collectLocked();
+}
+
+std::vector<ProfileEvent> Profiler::getEvents() {
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    collectLocked();
+    return std::vector<ProfileEvent>(history.begin(), history.end());
+}
+
+bool Profiler::exportChromeTrace(const std::string& path) {
+    // Nothing else may be locked under profilerMutex (lock instrumentation
+    // calls in while holding other locks), so unlock before logging
+    std::unique_lock<std::mutex> lock(profilerMutex);
+    collectLocked();
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        lock.unlock();
+        LOG_ERROR("Failed to write profiler trace: " + path);
+        return false;
+    }
+
+    // Complete ("X") events in microseconds; nesting on a thread is implied by the time ranges
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    for (const auto& buffer : threads) {
+        out << (first ? "" : ",\n")
+            << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->index
+            << ",\"args\":{\"name\":\"";
+        writeEscaped(out, buffer->name.c_str());
+        out << "\"}}";
+        first = false;
+    }
+    out << std::fixed << std::setprecision(3);
+    for (const ProfileEvent& event : history) {
+        out << (first ? "" : ",\n") << "{\"name\":\"";
+        writeEscaped(out, event.zone->name);
+        out << "\",\"cat\":\"";
+        writeEscaped(out, event.zone->category);
+        out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+            << ",\"ts\":" << event.start / 1000.0
+            << ",\"dur\":" << (event.end - event.start) / 1000.0
+            << ",\"args\":{\"depth\":" << event.depth << "}}";
+        first = false;
+    }
+    out << "\n]}\n";
+    size_t eventCount = history.size();
+    lock.unlock();
+    LOG_INFO("Wrote " + std::to_string(eventCount) + " profiler events to " + path);
+    return static_cast<bool>(out);
+}
+
+void Profiler::clear() {
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    collectLocked();
+    history.clear();
+    for (const auto& buffer : threads) {
+        buffer->dropped.store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t Profiler::getDroppedEventCount() const {
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    size_t dropped = 0;
+    for (const auto& buffer : threads) {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
@@ -8,6 +8,13 @@
 #include <iomanip>
 #include <sstream>
 #include "ResourceManager.h"
+#include "ShaderCache.h"
+#include "AllocationTracker.h"
+#include "FrameArena.h"
+#include "EngineConfig.h"
+#include "EngineBackend.h"
+#include <algorithm>
+#include <cstdio>
 
 Renderer::Renderer() {
     // Enable depth testing
@@ -41,42 +48,45 @@ bool Renderer::initialize() {
 }
 
 bool Renderer::createShaders() {
-    // Read shader files
-    std::string vertexCode, fragmentCode;
-    std::ifstream vShaderFile, fShaderFile;
+    // Load shader sources from the asset pack or loose files; GL takes explicit
+    // lengths so the bytes are passed as-is
+    ResourceData vShaderFile, fShaderFile;
     
-    vShaderFile.open(ResourceManager::getResourcePath("shaders/vertex.glsl"));
-    fShaderFile.open(ResourceManager::getResourcePath("shaders/fragment.glsl"));
-    
-    if (!vShaderFile.is_open() || !fShaderFile.is_open()) {
+    if (!ResourceManager::loadResource("shaders/vertex.glsl", vShaderFile) ||
+        !ResourceManager::loadResource("shaders/fragment.glsl", fShaderFile)) {
         std::cerr << "Failed to open shader files" << std::endl;
         return false;
     }
 
-    std::stringstream vShaderStream, fShaderStream;
-    vShaderStream << vShaderFile.rdbuf();
-    fShaderStream << fShaderFile.rdbuf();
-    
-    vertexCode = vShaderStream.str();
-    fragmentCode = fShaderStream.str();
-
-    // Compile shaders
-    const char* vShaderCode = vertexCode.c_str();
-    const char* fShaderCode = fragmentCode.c_str();
-
-    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vShaderCode, nullptr);
-    glCompileShader(vertexShader);
-
-    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fShaderCode, nullptr);
-    glCompileShader(fragmentShader);
-
-    // Create shader program
-    shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
+    // Reuse the driver binary from a previous run when there is one
+    shaderProgram = ShaderCache::loadProgram(vShaderFile.view(), fShaderFile.view());
+    if (shaderProgram == 0) {
+        // Compile shaders
+        const char* vShaderCode = vShaderFile.view().data();
+        const char* fShaderCode = fShaderFile.view().data();
+        GLint vShaderLength = static_cast<GLint>(vShaderFile.size());
+        GLint fShaderLength = static_cast<GLint>(fShaderFile.size());
+
+        GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(vertexShader, 1, &vShaderCode, &vShaderLength);
+        glCompileShader(vertexShader);
+
+        GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(fragmentShader, 1, &fShaderCode, &fShaderLength);
+        glCompileShader(fragmentShader);
+
+        // Create shader program
+        shaderProgram = glCreateProgram();
+        glAttachShader(shaderProgram, vertexShader);
+        glAttachShader(shaderProgram, fragmentShader);
+        ShaderCache::prepareProgram(shaderProgram);
+        glLinkProgram(shaderProgram);
+        ShaderCache::storeProgram(shaderProgram, vShaderFile.view(), fShaderFile.view());
+
+        // Clean up
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+    }
 
     // Get uniform locations
     modelLoc = glGetUniformLocation(shaderProgram, "model");
@@ -84,10 +94,6 @@ bool Renderer::createShaders() {
     projLoc = glGetUniformLocation(shaderProgram, "projection");
     colorLoc = glGetUniformLocation(shaderProgram, "color");
 
-    // Clean up
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
     return true;
 }
 
@@ -117,6 +123,7 @@ void Renderer::render(const World& world) {
 }
 
 void Renderer::render(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPos) {
+    AllocationScope allocations(AllocationTag::Render, true);
     clear();
     
     // Render grid
@@ -126,9 +133,10 @@ void Renderer::render(const glm::mat4& view, const glm::mat4& projection, const
     glDisable(GL_DEPTH_TEST);
 
     // Format camera position for display
-    std::stringstream ss;
-    ss << std::fixed << std::setprecision(2);
-    ss << "X: " << cameraPos.x << " Y: " << cameraPos.y << " Z: " << cameraPos.z;
+    ScratchScope scratch;
+    char buffer[96];
+    std::snprintf(buffer, sizeof(buffer), "X: %.2f Y: %.2f Z: %.2f", cameraPos.x, cameraPos.y, cameraPos.z);
+    std::pmr::string cameraText(buffer, scratch.resource());
     
     // Calculate text position (top right corner with padding)
     float paddingRight = 20.0f; // Fixed padding from the right edge
@@ -137,13 +145,40 @@ void Renderer::render(const glm::mat4& view, const glm::mat4& projection, const
 
     // Render coordinates in top right corner with padding
     textRenderer->renderText(
-        ss.str(),
-        width - paddingRight - textRenderer->getTextWidth(ss.str(), textScale),
+        cameraText,
+        width - paddingRight - textRenderer->getTextWidth(cameraText, textScale),
         height - paddingTop,
         textScale,
         glm::vec3(1.0f, 1.0f, 1.0f)
     );
 
+    // debug.visualization.text_stress_labels fills the screen with labels, every
+    // other one changing each frame, to measure text batching
+    int stressLabels = EngineConfig::getInstance().getTextStressLabels();
+    if (stressLabels > 0) {
+        static uint32_t stressFrame = 0;
+        ++stressFrame;
+        const float lineHeight = 10.0f;
+        const float columnWidth = 160.0f;
+        int rows = std::max(1, static_cast<int>((height - 2 * paddingTop) / lineHeight));
+        for (int i = 0; i < stressLabels; ++i) {
+            if (i % 2 == 0) {
+                std::snprintf(buffer, sizeof(buffer), "Body %d: static", i);
+            } else {
+                std::snprintf(buffer, sizeof(buffer), "Body %d: %u", i, stressFrame);
+            }
+            float x = 10.0f + (i / rows) * columnWidth;
+            float y = paddingTop + (i % rows) * lineHeight;
+            textRenderer->renderText(buffer, x, y, 1.0f, glm::vec3(0.6f + 0.4f * (i % 2), 0.8f, 1.0f));
+        }
+    }
+
+    PerformanceMonitor::RenderStats stats;
+    stats.drawCalls = textRenderer->flush();
+    stats.triangles = stats.fullDetailTriangles = 2 * textRenderer->getLastGlyphCount();
+    stats.vertices = stats.fullDetailVertices = 6 * textRenderer->getLastGlyphCount();
+    PerformanceMonitor::getInstance().addRenderStats(stats);
+
     // Re-enable depth testing
     glEnable(GL_DEPTH_TEST);
 }
@@ -1,18 +1,62 @@
 #include "ResourceManager.h"
+#include "AssetPack.h"
+#include "Profiler.h"
+#include "AllocationTracker.h"
 #include <filesystem>
 
 std::filesystem::path ResourceManager::executablePath;
+std::unique_ptr<AssetPack> ResourceManager::pack;
+
+namespace {
+const char* const DEFAULT_PACK_NAME = "assets.pak";
+}
 
 void ResourceManager::initialize(const char* argv0) {
     // Get the executable's directory
     executablePath = std::filesystem::path(argv0).parent_path();
+    std::filesystem::path buildPath = executablePath;
     
     // If the executable is in the build directory, go up one level to find resources
     if (executablePath.filename() == "build") {
         executablePath = executablePath.parent_path();
     }
+
+    // The build step writes the pack next to the executable
+    for (const auto& directory : {buildPath, executablePath}) {
+        std::filesystem::path packPath = directory / DEFAULT_PACK_NAME;
+        if (std::filesystem::exists(packPath) && mountPack(packPath.string())) {
+            break;
+        }
+    }
 }
 
 std::string ResourceManager::getResourcePath(const std::string& relativePath) {
     return (executablePath / relativePath).string();
-} 
\ No newline at end of file
+}
+
+bool ResourceManager::mountPack(const std::string& packPath) {
+    auto mounted = std::make_unique<AssetPack>();
+    if (!mounted->open(packPath)) {
+        LOG_WARNING("Failed to mount asset pack: " + packPath);
+        return false;
+    }
+    LOG_INFO("Mounted asset pack " + packPath + " (" + std::to_string(mounted->getEntryCount()) + " entries)");
+    pack = std::move(mounted);
+    return true;
+}
+
+bool ResourceManager::loadResource(const std::string& relativePath, ResourceData& data) {
+    PROFILE_SCOPE_CATEGORY("ResourceManager::loadResource", "io");
+    AllocationScope allocations(AllocationTag::IO);
+    if (pack) {
+        if (auto bytes = pack->read(relativePath, data.buffer)) {
+            data.bytes = *bytes;
+            return true;
+        }
+    }
+    if (!data.file.open(getResourcePath(relativePath), AccessHint::Sequential)) {
+        return false;
+    }
+    data.bytes = data.file.view();
+    return true;
+}
@@ -1,12 +1,37 @@
 #pragma once
 #include <string>
+#include <string_view>
+#include <vector>
 #include <filesystem>
+#include "EngineBackend.h"
+
+class AssetPack;
+
+// Bytes of a loaded resource. The view points into the mounted pack, a
+// mapping of the loose file, or a decompressed buffer owned by this object.
+class ResourceData {
+public:
+    std::string_view view() const { return bytes; }
+    const char* data() const { return bytes.data(); }
+    size_t size() const { return bytes.size(); }
+
+private:
+    friend class ResourceManager;
+    std::string_view bytes;
+    MappedFile file;
+    std::vector<uint8_t> buffer;
+};
 
 class ResourceManager {
 public:
     static void initialize(const char* argv0);
     static std::string getResourcePath(const std::string& relativePath);
 
+    // Mounts a pack built by asset-packer; mounted packs are searched before loose files
+    static bool mountPack(const std::string& packPath);
+    static bool loadResource(const std::string& relativePath, ResourceData& data);
+
 private:
     static std::filesystem::path executablePath;
-}; 
\ No newline at end of file
+    static std::unique_ptr<AssetPack> pack;
+};
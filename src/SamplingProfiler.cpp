@@ -0,0 +1,340 @@
+#include "SamplingProfiler.h"
+#include "EngineBackend.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#define SAMPLING_PROFILER_SUPPORTED 1
+#include <csignal>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr uint64_t HEADER_COMMITTED = uint64_t(1) << 63;
+constexpr uint64_t HEADER_PADDING = uint64_t(1) << 62;
+constexpr uint64_t HEADER_LENGTH_MASK = 0xFFFFFFFFull;
+constexpr uint64_t STACK_SCAN_LIMIT = 8 * 1024 * 1024;
+constexpr uint64_t MAX_FRAME_SIZE = 1024 * 1024;
+
+#ifdef SAMPLING_PROFILER_SUPPORTED
+uint64_t clockNanos(clockid_t clock) {
+    timespec ts;
+    clock_gettime(clock, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+// A register that is not really a frame pointer can point anywhere; mincore()
+// fails with ENOMEM on unmapped pages, so the walk never faults. Checked pages
+// are remembered, since most frames of a sample share one or two pages.
+bool isMapped(uintptr_t address, uintptr_t& lastMappedPage) {
+    static const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    uintptr_t page = address & ~(pageSize - 1);
+    if (page == lastMappedPage) {
+        return true;
+    }
+    unsigned char residency;
+    if (mincore(reinterpret_cast<void*>(page), pageSize, &residency) != 0) {
+        return false;
+    }
+    lastMappedPage = page;
+    return true;
+}
+
+void handleSignal(int, siginfo_t*, void* context) {
+    int savedErrno = errno;
+    uint64_t begin = clockNanos(CLOCK_MONOTONIC);
+
+    const ucontext_t* uc = static_cast<const ucontext_t*>(context);
+#if defined(__x86_64__)
+    uintptr_t pc = static_cast<uintptr_t>(uc->uc_mcontext.gregs[REG_RIP]);
+    uintptr_t fp = static_cast<uintptr_t>(uc->uc_mcontext.gregs[REG_RBP]);
+    uintptr_t sp = static_cast<uintptr_t>(uc->uc_mcontext.gregs[REG_RSP]);
+#else
+    uintptr_t pc = static_cast<uintptr_t>(uc->uc_mcontext.pc);
+    uintptr_t fp = static_cast<uintptr_t>(uc->uc_mcontext.regs[29]);
+    uintptr_t sp = static_cast<uintptr_t>(uc->uc_mcontext.sp);
+#endif
+
+    uintptr_t frames[SamplingProfiler::MAX_DEPTH];
+    uint32_t depth = 0;
+    frames[depth++] = pc;
+    uintptr_t lastMappedPage = 0;
+    // Each frame holds {caller's frame pointer, return address}; frames only move up the stack
+    while (depth < SamplingProfiler::MAX_DEPTH && fp >= sp && fp - sp < STACK_SCAN_LIMIT &&
+           fp % sizeof(uintptr_t) == 0 &&
+           isMapped(fp, lastMappedPage) && isMapped(fp + sizeof(uintptr_t), lastMappedPage)) {
+        const uintptr_t* frame = reinterpret_cast<const uintptr_t*>(fp);
+        uintptr_t next = frame[0];
+        uintptr_t returnAddress = frame[1];
+        if (returnAddress == 0) {
+            break;
+        }
+        frames[depth++] = returnAddress;
+        if (next <= fp || next - fp > MAX_FRAME_SIZE) {
+            break;
+        }
+        fp = next;
+    }
+
+    SamplingProfiler& profiler = SamplingProfiler::getInstance();
+    profiler.recordSample(frames, depth);
+    profiler.addHandlerTime(clockNanos(CLOCK_MONOTONIC) - begin);
+    errno = savedErrno;
+}
+#endif
+}
+
+SamplingProfiler& SamplingProfiler::getInstance() {
+    static SamplingProfiler instance;
+    return instance;
+}
+
+SamplingProfiler::SamplingProfiler() {}
+
+SamplingProfiler::~SamplingProfiler() {
+    stop();
+}
+
+void SamplingProfiler::recordSample(const uintptr_t* frames, uint32_t depth) {
+    // Runs in signal context: atomics only, no allocation, no locks
+    uint64_t need = depth + 1;
+    uint64_t cursor = writeCursor.load(std::memory_order_relaxed);
+    uint64_t padding;
+    do {
+        uint64_t offset = cursor % RING_WORDS;
+        padding = offset + need > RING_WORDS ? RING_WORDS - offset : 0;  // Records never wrap
+        if (cursor + padding + need - readCursor.load(std::memory_order_acquire) > RING_WORDS) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    } while (!writeCursor.compare_exchange_weak(cursor, cursor + padding + need,
+                                                std::memory_order_acq_rel, std::memory_order_relaxed));
+
+    if (padding) {
+        ring[cursor % RING_WORDS].store(HEADER_COMMITTED | HEADER_PADDING | padding, std::memory_order_release);
+    }
+    uint64_t start = cursor + padding;
+    for (uint32_t i = 0; i < depth; ++i) {
+        ring[(start + 1 + i) % RING_WORDS].store(frames[i], std::memory_order_relaxed);
+    }
+    ring[start % RING_WORDS].store(HEADER_COMMITTED | need, std::memory_order_release);
+}
+
+void SamplingProfiler::addHandlerTime(uint64_t nanos) {
+    handlerNanos.fetch_add(nanos, std::memory_order_relaxed);
+}
+
+bool SamplingProfiler::start(int rateHz) {
+#ifdef SAMPLING_PROFILER_SUPPORTED
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    if (running.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    if (rateHz <= 0 || rateHz > 10000) {
+        LOG_ERROR("Invalid sampling rate: " + std::to_string(rateHz));
+        return false;
+    }
+    if (!ring) {
+        ring.reset(new std::atomic<uint64_t>[RING_WORDS]());
+    }
+
+    struct sigaction action = {};
+    action.sa_sigaction = handleSignal;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, nullptr) != 0) {
+        LOG_ERROR("Failed to install SIGPROF handler");
+        return false;
+    }
+
+    // ITIMER_PROF counts process CPU time, so idle threads are never sampled
+    itimerval timer = {};
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = std::max(1, 1000000 / rateHz);
+    timer.it_value = timer.it_interval;
+    startCpuNanos = clockNanos(CLOCK_PROCESS_CPUTIME_ID);
+    handlerNanos.store(0, std::memory_order_relaxed);
+    running.store(true, std::memory_order_relaxed);
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        running.store(false, std::memory_order_relaxed);
+        signal(SIGPROF, SIG_IGN);
+        LOG_ERROR("Failed to start profiling timer");
+        return false;
+    }
+
+    collector = std::thread(&SamplingProfiler::collectorLoop, this);
+    LOG_INFO("Sampling profiler started at " + std::to_string(rateHz) + " Hz");
+    return true;
+#else
+    (void)rateHz;
+    LOG_WARNING("Sampling profiler is not supported on this platform");
+    return false;
+#endif
+}
+
+void SamplingProfiler::stop() {
+#ifdef SAMPLING_PROFILER_SUPPORTED
+    {
+        std::lock_guard<std::mutex> lock(profilerMutex);
+        if (!running.load(std::memory_order_relaxed)) {
+            return;
+        }
+        itimerval timer = {};
+        setitimer(ITIMER_PROF, &timer, nullptr);
+        // A signal already in flight is ignored rather than killing the process
+        signal(SIGPROF, SIG_IGN);
+        {
+            std::lock_guard<std::mutex> collectorLock(collectorMutex);
+            running.store(false, std::memory_order_relaxed);
+        }
+    }
+    collectorCondition.notify_all();
+    if (collector.joinable()) {
+        collector.join();
+    }
+    collect();
+
+    double overhead = getOverhead();
+    std::stringstream ss;
+    ss << "Sampling profiler stopped: " << getSampleCount() << " samples, "
+       << getDroppedSampleCount() << " dropped, overhead " << overhead * 100.0 << "%";
+    if (overhead > 0.02) {
+        LOG_WARNING(ss.str() + "; lower debug.profiling.sampling.rate_hz");
+    } else {
+        LOG_INFO(ss.str());
+    }
+#endif
+}
+
+void SamplingProfiler::collectorLoop() {
+    std::unique_lock<std::mutex> lock(collectorMutex);
+    while (running.load(std::memory_order_relaxed)) {
+        collectorCondition.wait_for(lock, std::chrono::milliseconds(200));
+        lock.unlock();
+        collect();
+        lock.lock();
+    }
+}
+
+void SamplingProfiler::collect() {
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    if (!ring) {
+        return;
+    }
+    uint64_t read = readCursor.load(std::memory_order_relaxed);
+    uint64_t write = writeCursor.load(std::memory_order_acquire);
+    std::vector<uintptr_t> frames;
+    while (read < write) {
+        std::atomic<uint64_t>& headerSlot = ring[read % RING_WORDS];
+        uint64_t header = headerSlot.load(std::memory_order_acquire);
+        if (!(header & HEADER_COMMITTED)) {
+            break;  // Reserved but still being written; pick it up next time
+        }
+        uint64_t length = header & HEADER_LENGTH_MASK;
+        if (!(header & HEADER_PADDING)) {
+            frames.resize(length - 1);
+            for (uint64_t i = 0; i + 1 < length; ++i) {
+                frames[i] = static_cast<uintptr_t>(ring[(read + 1 + i) % RING_WORDS].load(std::memory_order_relaxed));
+            }
+            stacks[frames]++;
+            collected++;
+        }
+        // Zeroed so a stale header is never mistaken for a new one after wrapping
+        headerSlot.store(0, std::memory_order_relaxed);
+        read += length;
+        readCursor.store(read, std::memory_order_release);
+    }
+}
+
+std::string SamplingProfiler::symbolize(uintptr_t address) {
+    std::stringstream ss;
+#ifdef SAMPLING_PROFILER_SUPPORTED
+    Dl_info info{};
+    // Return addresses point after the call; step back into the calling instruction.
+    // dladdr leaves info untouched when it fails, so nothing is read unless it succeeded
+    int found = dladdr(reinterpret_cast<void*>(address - 1), &info);
+    if (found && info.dli_sname) {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        std::string name = status == 0 && demangled ? demangled : info.dli_sname;
+        std::free(demangled);
+        std::replace(name.begin(), name.end(), ';', ':');
+        return name;
+    }
+    if (found && info.dli_fname) {
+        std::string module = info.dli_fname;
+        size_t slash = module.find_last_of('/');
+        ss << module.substr(slash == std::string::npos ? 0 : slash + 1) << "+0x" << std::hex
+           << address - reinterpret_cast<uintptr_t>(info.dli_fbase);
+        return ss.str();
+    }
+#endif
+    ss << "0x" << std::hex << address;
+    return ss.str();
+}
+
+bool SamplingProfiler::writeFoldedStacks(const std::string& path) {
+    collect();
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        LOG_ERROR("Failed to write folded stacks: " + path);
+        return false;
+    }
+
+    // Symbolize each distinct address once, after sampling has finished. Stacks
+    // that differ only in addresses inside the same function fold together.
+    std::unordered_map<uintptr_t, std::string> names;
+    std::map<std::string, uint64_t> folded;
+    for (const auto& [frames, count] : stacks) {
+        std::string line;
+        for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+            auto name = names.find(*it);
+            if (name == names.end()) {
+                name = names.emplace(*it, symbolize(*it)).first;
+            }
+            if (!line.empty()) {
+                line += ';';
+            }
+            line += name->second;
+        }
+        folded[line] += count;
+    }
+    for (const auto& [line, count] : folded) {
+        out << line << ' ' << count << '\n';
+    }
+    LOG_INFO("Wrote " + std::to_string(folded.size()) + " folded stacks to " + path);
+    return static_cast<bool>(out);
+}
+
+void SamplingProfiler::clear() {
+    collect();
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    stacks.clear();
+    collected = 0;
+    dropped.store(0, std::memory_order_relaxed);
+}
+
+uint64_t SamplingProfiler::getSampleCount() const {
+    std::lock_guard<std::mutex> lock(profilerMutex);
+    return collected;
+}
+
+double SamplingProfiler::getOverhead() const {
+#ifdef SAMPLING_PROFILER_SUPPORTED
+    uint64_t cpu = clockNanos(CLOCK_PROCESS_CPUTIME_ID) - startCpuNanos;
+    return cpu ? static_cast<double>(handlerNanos.load(std::memory_order_relaxed)) / cpu : 0.0;
+#else
+    return 0.0;
+#endif
+}
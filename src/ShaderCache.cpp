@@ -0,0 +1,91 @@
+#include "ShaderCache.h"
+#include "DerivedAssetCache.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+std::string glString(GLenum name) {
+    const GLubyte* value = glGetString(name);
+    return value ? reinterpret_cast<const char*>(value) : "";
+}
+
+std::string programKey(std::string_view vertexSource, std::string_view fragmentSource) {
+    return DerivedAssetCache::KeyBuilder("gl-program")
+        .add(glString(GL_VENDOR))
+        .add(glString(GL_RENDERER))
+        .add(glString(GL_VERSION))
+        .add(vertexSource)
+        .add(fragmentSource)
+        .finish();
+}
+}
+
+bool ShaderCache::isSupported() {
+    if (!GLAD_GL_VERSION_4_1) {
+        return false;
+    }
+    // Some drivers expose the entry points but support no binary formats
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+GLuint ShaderCache::loadProgram(std::string_view vertexSource, std::string_view fragmentSource) {
+    if (!isSupported()) {
+        return 0;
+    }
+
+    std::string key = programKey(vertexSource, fragmentSource);
+    MappedFile file;
+    std::string_view payload;
+    GLenum format;
+    if (!DerivedAssetCache::getInstance().load(key, file, payload) || payload.size() <= sizeof(format)) {
+        return 0;
+    }
+    std::memcpy(&format, payload.data(), sizeof(format));
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, format, payload.data() + sizeof(format),
+                    static_cast<GLsizei>(payload.size() - sizeof(format)));
+    GLint success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        // The driver is free to reject its own binaries (e.g. after an update)
+        glDeleteProgram(program);
+        file.close();
+        DerivedAssetCache::getInstance().invalidate(key);
+        return 0;
+    }
+    return program;
+}
+
+void ShaderCache::prepareProgram(GLuint program) {
+    if (isSupported()) {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+}
+
+void ShaderCache::storeProgram(GLuint program, std::string_view vertexSource, std::string_view fragmentSource) {
+    if (!isSupported()) {
+        return;
+    }
+    GLint success = 0;
+    GLint length = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (!success || length <= 0) {
+        return;
+    }
+
+    // Payload: binary format followed by the driver's blob
+    GLenum format = 0;
+    std::vector<char> payload(sizeof(format) + length);
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, payload.data() + sizeof(format));
+    if (written <= 0) {
+        return;
+    }
+    std::memcpy(payload.data(), &format, sizeof(format));
+    DerivedAssetCache::getInstance().store(programKey(vertexSource, fragmentSource),
+                                           payload.data(), sizeof(format) + written);
+}
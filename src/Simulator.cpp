@@ -1,6 +1,11 @@
 #include "Simulator.h"
 #include "World.h"
+#include "Profiler.h"
+#include "PerfCounters.h"
+#include "AllocationTracker.h"
+#include "FrameArena.h"
 #include <iostream>
+#include <algorithm>
 
 Simulator::Simulator(World& world) : world(world) {}
 
@@ -9,27 +14,44 @@ void Simulator::clear() {
 }
 
 void Simulator::calculateForces() {
+    PROFILE_SCOPE_COUNTERS("Simulator::calculateForces", "physics");
     const double G = 6.67430e-11; // Gravitational constant
     size_t n = world.getBodyCount();
-    // Reset accelerations
+
+    // Gather positions and masses into per-thread scratch so the pair loop
+    // reads contiguous arrays; nothing here touches the heap after warm-up
+    ScratchScope scratch;
+    std::pmr::vector<Vector> positions(scratch.resource());
+    std::pmr::vector<double> masses(scratch.resource());
+    std::pmr::vector<Vector> accelerations(n, Vector(), scratch.resource());
+    positions.reserve(n);
+    masses.reserve(n);
     for (size_t i = 0; i < n; ++i) {
-        world.getBody(i).acceleration = Vector();
+        const Body& body = world.getBody(i);
+        positions.push_back(body.position);
+        masses.push_back(body.mass);
     }
+
     // Calculate gravitational forces between all pairs of bodies
     for (size_t i = 0; i < n; ++i) {
         for (size_t j = i + 1; j < n; ++j) {
-            Vector r = world.getBody(j).position - world.getBody(i).position;
+            Vector r = positions[j] - positions[i];
             double r_mag = r.magnitude();
             if (r_mag == 0) continue;
-            double force_mag = G * world.getBody(i).mass * world.getBody(j).mass / (r_mag * r_mag);
+            double force_mag = G * masses[i] * masses[j] / (r_mag * r_mag);
             Vector force = r.normalize() * force_mag;
-            world.getBody(i).acceleration = world.getBody(i).acceleration + force / world.getBody(i).mass;
-            world.getBody(j).acceleration = world.getBody(j).acceleration - force / world.getBody(j).mass;
+            accelerations[i] = accelerations[i] + force / masses[i];
+            accelerations[j] = accelerations[j] - force / masses[j];
         }
     }
+
+    for (size_t i = 0; i < n; ++i) {
+        world.getBody(i).acceleration = accelerations[i];
+    }
 }
 
 void Simulator::updatePositions(double dt) {
+    PROFILE_SCOPE_CATEGORY("Simulator::updatePositions", "physics");
     size_t n = world.getBodyCount();
     for (size_t i = 0; i < n; ++i) {
         Body& body = world.getBody(i);
@@ -39,6 +61,16 @@ void Simulator::updatePositions(double dt) {
 }
 
 void Simulator::step(double dt) {
+    PROFILE_SCOPE_CATEGORY("Simulator::step", "physics");
+    AllocationScope allocations(AllocationTag::Physics, true);
+    PerfCounterScope counters;
     calculateForces();
     updatePositions(dt);
+
+    const PerfSample& delta = counters.stop();
+    double bodies = static_cast<double>(std::max<size_t>(world.getBodyCount(), 1));
+    stepCounters.ipc = delta.getIPC();
+    stepCounters.l1dMissesPerBody = delta.get(PerfCounter::L1DMisses) / bodies;
+    stepCounters.llcMissesPerBody = delta.get(PerfCounter::LLCMisses) / bodies;
+    stepCounters.branchMissesPerBody = delta.get(PerfCounter::BranchMisses) / bodies;
 } 
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "StreamingBuffer.h"
+#include "EngineBackend.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+constexpr GLbitfield PERSISTENT_FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+}
+
+StreamingBuffer::StreamingBuffer(GLsizeiptr capacity) {
+    create(std::max<GLsizeiptr>(capacity, 256));
+}
+
+StreamingBuffer::~StreamingBuffer() {
+    destroy();
+}
+
+bool StreamingBuffer::isPersistentMappingSupported() {
+    // glad loads glBufferStorage for GL 4.4 contexts
+    return GLAD_GL_VERSION_4_4 && glBufferStorage != nullptr;
+}
+
+void StreamingBuffer::create(GLsizeiptr newCapacity) {
+    destroy();
+    capacity = newCapacity;
+    glGenBuffers(1, &bufferId);
+    glBindBuffer(GL_ARRAY_BUFFER, bufferId);
+    if (isPersistentMappingSupported()) {
+        glBufferStorage(GL_ARRAY_BUFFER, capacity, nullptr, PERSISTENT_FLAGS);
+        mapped = static_cast<char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, capacity, PERSISTENT_FLAGS));
+        if (!mapped) {
+            // Storage is immutable, so orphaning needs a fresh buffer
+            glDeleteBuffers(1, &bufferId);
+            glGenBuffers(1, &bufferId);
+            glBindBuffer(GL_ARRAY_BUFFER, bufferId);
+        }
+    }
+    if (!mapped) {
+        glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+    }
+    head = 0;
+    frameStart = 0;
+    frameBytes = 0;
+}
+
+void StreamingBuffer::destroy() {
+    for (const Region& region : inFlight) {
+        glDeleteSync(region.fence);
+    }
+    inFlight.clear();
+    if (bufferId == 0) {
+        return;
+    }
+    if (mapped) {
+        glBindBuffer(GL_ARRAY_BUFFER, bufferId);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        mapped = nullptr;
+    }
+    // Draws already queued keep the old storage alive
+    glDeleteBuffers(1, &bufferId);
+    bufferId = 0;
+}
+
+GLintptr StreamingBuffer::upload(const void* data, GLsizeiptr size, GLsizeiptr alignment) {
+    alignment = std::max<GLsizeiptr>(alignment, 1);
+    GLintptr offset = (head + alignment - 1) / alignment * alignment;
+    bool wraps = offset + size > capacity;
+    GLsizeiptr skipped = wraps ? capacity - head : offset - head;
+    if (wraps) {
+        offset = 0;
+    }
+
+    if (frameBytes + skipped + size > capacity) {
+        // This frame alone would lap its own data
+        GLsizeiptr newCapacity = capacity * 2;
+        while (newCapacity < frameBytes + size + alignment) {
+            newCapacity *= 2;
+        }
+        LOG_WARNING("StreamingBuffer grew to " + std::to_string(newCapacity / 1024) +
+                    " KB; a frame uploaded more than the ring holds");
+        create(newCapacity);
+        growCount++;
+        offset = 0;
+        skipped = 0;
+    } else if (wraps) {
+        if (mapped) {
+            waitForRange(head, capacity);
+        } else {
+            glBindBuffer(GL_ARRAY_BUFFER, bufferId);
+            glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+        }
+    }
+
+    if (mapped) {
+        waitForRange(offset, offset + size);
+        std::memcpy(mapped + offset, data, static_cast<size_t>(size));
+    } else {
+        glBindBuffer(GL_ARRAY_BUFFER, bufferId);
+        glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+    }
+    head = offset + size;
+    frameBytes += skipped + size;
+    return offset;
+}
+
+void StreamingBuffer::endFrame() {
+    if (frameBytes == 0) {
+        return;
+    }
+    if (mapped) {
+        inFlight.push_back(Region{glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), frameStart, frameBytes});
+    }
+    frameStart = head;
+    frameBytes = 0;
+}
+
+void StreamingBuffer::waitForRange(GLintptr begin, GLintptr end) {
+    // Regions sit in ring order ahead of head, so only the oldest can be next in the way
+    while (!inFlight.empty()) {
+        const Region& region = inFlight.front();
+        GLintptr regionEnd = std::min<GLintptr>(region.begin + region.size, capacity);
+        GLintptr wrappedEnd = region.begin + region.size - capacity;
+        bool overlaps = (begin < regionEnd && region.begin < end) || (wrappedEnd > 0 && begin < wrappedEnd);
+        if (!overlaps) {
+            break;
+        }
+        GLenum result = glClientWaitSync(region.fence, 0, 0);
+        if (result == GL_TIMEOUT_EXPIRED) {
+            stallCount++;
+            do {
+                result = glClientWaitSync(region.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+            } while (result == GL_TIMEOUT_EXPIRED);
+        }
+        glDeleteSync(region.fence);
+        inFlight.pop_front();
+    }
+}
@@ -1,7 +1,15 @@
 #include "TextRenderer.h"
+#include "DerivedAssetCache.h"
+#include "ShaderCache.h"
+#include "Profiler.h"
 #include <iostream>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
 
 // Simple 8x8 bitmap font data (ASCII characters 0-127)
 static const unsigned char fontData[128][8] = {
@@ -136,7 +144,7 @@ static const unsigned char fontData[128][8] = {
 };
 
 TextRenderer::TextRenderer(unsigned int width, unsigned int height)
-    : viewportWidth(width), viewportHeight(height) {
+    : attributeBuffer(0), viewportWidth(width), viewportHeight(height) {
     setupBuffers();
     createShaders();
     createFontTexture();
@@ -144,7 +152,7 @@ TextRenderer::TextRenderer(unsigned int width, unsigned int height)
 
 TextRenderer::~TextRenderer() {
     glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
+    vertexStream.reset();
     glDeleteProgram(shaderProgram);
     glDeleteTextures(1, &fontTexture);
 }
@@ -163,6 +171,24 @@ void TextRenderer::createFontTexture() {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     
+    // The atlas is derived from the bitmap table and its layout; a previous run
+    // may already have baked it
+    const int atlasWidth = CHAR_WIDTH * CHARS_PER_ROW;
+    const int atlasHeight = CHAR_HEIGHT * CHARS_PER_COL;
+    std::string atlasKey = DerivedAssetCache::KeyBuilder("font-atlas")
+        .add(fontData, sizeof(fontData))
+        .add(atlasWidth)
+        .add(atlasHeight)
+        .finish();
+    MappedFile cachedAtlas;
+    std::string_view cachedPixels;
+    if (DerivedAssetCache::getInstance().load(atlasKey, cachedAtlas, cachedPixels) &&
+        cachedPixels.size() == size_t(atlasWidth) * atlasHeight) {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, atlasWidth, atlasHeight,
+                     0, GL_RED, GL_UNSIGNED_BYTE, cachedPixels.data());
+        return;
+    }
+
     // Create a temporary buffer to arrange font data for the texture
     unsigned char textureData[CHAR_WIDTH * CHARS_PER_ROW * CHAR_HEIGHT * CHARS_PER_COL];
     memset(textureData, 0, sizeof(textureData)); // Initialize with zeros
@@ -190,20 +216,25 @@ void TextRenderer::createFontTexture() {
                  CHAR_WIDTH * CHARS_PER_ROW, 
                  CHAR_HEIGHT * CHARS_PER_COL, 
                  0, GL_RED, GL_UNSIGNED_BYTE, textureData);
+    DerivedAssetCache::getInstance().store(atlasKey, textureData, sizeof(textureData));
 }
 
 bool TextRenderer::createShaders() {
     // Vertex shader
     const char* vertexShaderSource = R"(
         #version 330 core
-        layout (location = 0) in vec4 vertex; // <vec2 pos, vec2 tex>
+        layout (location = 0) in vec2 position;
+        layout (location = 1) in vec2 texCoord;
+        layout (location = 2) in vec4 glyphColor;
         out vec2 TexCoords;
+        out vec3 TextColor;
 
         uniform mat4 projection;
 
         void main() {
-            gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
-            TexCoords = vertex.zw;
+            gl_Position = projection * vec4(position, 0.0, 1.0);
+            TexCoords = texCoord;
+            TextColor = glyphColor.rgb;
         }
     )";
 
@@ -211,115 +242,169 @@ bool TextRenderer::createShaders() {
     const char* fragmentShaderSource = R"(
         #version 330 core
         in vec2 TexCoords;
+        in vec3 TextColor;
         out vec4 color;
 
         uniform sampler2D text;
-        uniform vec3 textColor;
 
         void main() {
             vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);
-            color = vec4(textColor, 1.0) * sampled;
+            color = vec4(TextColor, 1.0) * sampled;
         }
     )";
 
-    // Compile shaders
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-    glCompileShader(vertexShader);
-
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-    glCompileShader(fragmentShader);
-
-    // Create shader program
-    shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
+    // Reuse the driver binary from a previous run when there is one
+    shaderProgram = ShaderCache::loadProgram(vertexShaderSource, fragmentShaderSource);
+    if (shaderProgram == 0) {
+        // Compile shaders
+        unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
+        glCompileShader(vertexShader);
+
+        unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
+        glCompileShader(fragmentShader);
+
+        // Create shader program
+        shaderProgram = glCreateProgram();
+        glAttachShader(shaderProgram, vertexShader);
+        glAttachShader(shaderProgram, fragmentShader);
+        ShaderCache::prepareProgram(shaderProgram);
+        glLinkProgram(shaderProgram);
+        ShaderCache::storeProgram(shaderProgram, vertexShaderSource, fragmentShaderSource);
+
+        // Clean up
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+    }
 
     // Get uniform locations
-    textColorLoc = glGetUniformLocation(shaderProgram, "textColor");
     projectionLoc = glGetUniformLocation(shaderProgram, "projection");
 
-    // Clean up
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
     return true;
 }
 
 void TextRenderer::setupBuffers() {
     glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
+    vertexStream = std::make_unique<StreamingBuffer>(STREAM_SIZE);
     glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+    bindAttributes();
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
 }
 
-void TextRenderer::renderText(const std::string& text, float x, float y, float scale, const glm::vec3& color) {
-    // Activate corresponding render state
-    glUseProgram(shaderProgram);
-    glUniform3f(textColorLoc, color.x, color.y, color.z);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, fontTexture);
-    glBindVertexArray(VAO);
+// Points the VAO's attributes at the start of the stream's current buffer
+void TextRenderer::bindAttributes() {
+    attributeBuffer = vertexStream->buffer();
+    glBindBuffer(GL_ARRAY_BUFFER, attributeBuffer);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, VERTEX_SIZE, (void*)offsetof(GlyphVertex, x));
+    glVertexAttribPointer(1, 2, GL_UNSIGNED_SHORT, GL_TRUE, VERTEX_SIZE, (void*)offsetof(GlyphVertex, u));
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, VERTEX_SIZE, (void*)offsetof(GlyphVertex, color));
+}
 
-    // Create orthographic projection matrix
-    glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(viewportWidth), 
-                                     0.0f, static_cast<float>(viewportHeight));
-    glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, glm::value_ptr(projection));
+void TextRenderer::renderText(std::string_view text, float x, float y, float scale, const glm::vec3& color) {
+    const CachedLayout& layout = getLayout(text, scale);
+    uint32_t packedColor = glm::packUnorm4x8(glm::vec4(glm::clamp(color, 0.0f, 1.0f), 1.0f));
+    size_t first = pendingVertices.size();
+    pendingVertices.resize(first + layout.vertices.size());
+    GlyphVertex* out = pendingVertices.data() + first;
+    for (const GlyphVertex& vertex : layout.vertices) {
+        *out++ = {vertex.x + x, vertex.y + y, vertex.u, vertex.v, packedColor};
+    }
+}
 
-    // Enable blending
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+const TextRenderer::CachedLayout& TextRenderer::getLayout(std::string_view text, float scale) {
+    uint32_t scaleBits;
+    std::memcpy(&scaleBits, &scale, sizeof(scaleBits));
+    uint64_t key = std::hash<std::string_view>()(text) ^ (uint64_t(scaleBits) * 0x9E3779B97F4A7C15ull);
+    CachedLayout& layout = layoutCache[key];
+    layout.lastUsedFrame = frame;
+    if (layout.scale == scale && layout.text == text && !layout.vertices.empty()) {
+        return layout;
+    }
 
-    // Render each character
+    // New string, or a hash collision replacing an older one
+    layout.text.assign(text.data(), text.size());
+    layout.scale = scale;
+    layout.vertices.clear();
+    const float texWidth = 1.0f / CHARS_PER_ROW;
+    const float texHeight = 1.0f / CHARS_PER_COL;
+    const float w = CHAR_WIDTH * scale;
+    const float h = CHAR_HEIGHT * scale;
+    auto unorm = [](float value) { return static_cast<uint16_t>(value * 65535.0f + 0.5f); };
+    float x = 0.0f;
     for (unsigned char c : text) {
         if (c > 127) continue;  // Skip non-ASCII characters
 
-        // Calculate texture coordinates
-        float texX = (c % CHARS_PER_ROW) * (1.0f / CHARS_PER_ROW);
-        float texY = (c / CHARS_PER_ROW) * (1.0f / CHARS_PER_COL);
-        float texWidth = 1.0f / CHARS_PER_ROW;
-        float texHeight = 1.0f / CHARS_PER_COL;
-
-        float w = CHAR_WIDTH * scale;
-        float h = CHAR_HEIGHT * scale;
-
-        // Update VBO for each character
-        float vertices[6][4] = {
-            { x,     y + h,    texX + texWidth, texY },
-            { x,     y,        texX + texWidth, texY + texHeight },
-            { x + w, y,        texX, texY + texHeight },
-
-            { x,     y + h,    texX + texWidth, texY },
-            { x + w, y,        texX, texY + texHeight },
-            { x + w, y + h,    texX, texY }
-        };
-
-        // Render glyph texture over quad
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-
-        // Advance cursors for next glyph
+        // Texture coordinates; the atlas stores glyphs mirrored, so u runs right to left
+        uint16_t u0 = unorm((c % CHARS_PER_ROW) * texWidth);
+        uint16_t u1 = unorm((c % CHARS_PER_ROW) * texWidth + texWidth);
+        uint16_t v0 = unorm((c / CHARS_PER_ROW) * texHeight);
+        uint16_t v1 = unorm((c / CHARS_PER_ROW) * texHeight + texHeight);
+
+        layout.vertices.push_back({x,     h,    u1, v0, 0});
+        layout.vertices.push_back({x,     0.0f, u1, v1, 0});
+        layout.vertices.push_back({x + w, 0.0f, u0, v1, 0});
+        layout.vertices.push_back({x,     h,    u1, v0, 0});
+        layout.vertices.push_back({x + w, 0.0f, u0, v1, 0});
+        layout.vertices.push_back({x + w, h,    u0, v0, 0});
+
+        // Advance cursor for next glyph
         x += w;
     }
+    return layout;
+}
 
-    // Disable blending
-    glDisable(GL_BLEND);
+uint32_t TextRenderer::flush() {
+    PROFILE_SCOPE_CATEGORY("TextRenderer::flush", "render");
+    ++frame;
+    lastGlyphCount = pendingVertices.size() / 6;
+    if (layoutCache.size() > MAX_CACHED_LAYOUTS) {
+        // Labels that change every frame (timers, coordinates) would otherwise pile up
+        for (auto it = layoutCache.begin(); it != layoutCache.end();) {
+            it = it->second.lastUsedFrame + 1 < frame ? layoutCache.erase(it) : std::next(it);
+        }
+    }
+    if (pendingVertices.empty()) {
+        return 0;
+    }
 
+    glUseProgram(shaderProgram);
+    if (projectionDirty) {
+        glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(viewportWidth),
+                                          0.0f, static_cast<float>(viewportHeight));
+        glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, glm::value_ptr(projection));
+        projectionDirty = false;
+    }
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, fontTexture);
+    glBindVertexArray(VAO);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // The attributes point at the start of the ring, so a vertex-aligned
+    // offset is just a first-vertex index
+    GLsizeiptr bytes = static_cast<GLsizeiptr>(pendingVertices.size() * sizeof(GlyphVertex));
+    GLintptr offset = vertexStream->upload(pendingVertices.data(), bytes, VERTEX_SIZE);
+    if (vertexStream->buffer() != attributeBuffer) {
+        bindAttributes();
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDrawArrays(GL_TRIANGLES, static_cast<GLint>(offset / VERTEX_SIZE), static_cast<GLsizei>(pendingVertices.size()));
+    vertexStream->endFrame();
+    pendingVertices.clear();
+
+    glDisable(GL_BLEND);
     glBindVertexArray(0);
     glBindTexture(GL_TEXTURE_2D, 0);
+    return 1;
 }
 
 // Calculate the width of a text string
-float TextRenderer::getTextWidth(const std::string& text, float scale) const {
+float TextRenderer::getTextWidth(std::string_view text, float scale) const {
     float width = 0.0f;
     for (unsigned char c : text) {
         if (c > 127) continue;  // Skip non-ASCII characters
@@ -331,4 +416,5 @@ float TextRenderer::getTextWidth(const std::string& text, float scale) const {
 void TextRenderer::updateViewport(unsigned int width, unsigned int height) {
     viewportWidth = width;
     viewportHeight = height;
+    projectionDirty = true;
 } 
\ No newline at end of file
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <glm/glm.hpp>
 #include "glad/glad.h"
+#include "StreamingBuffer.h"
 #include <vector>
 
 class TextRenderer {
@@ -13,24 +18,54 @@ public:
     // Initialize the text renderer
     bool init();
     
-    // Render text
-    void renderText(const std::string& text, float x, float y, float scale, const glm::vec3& color = glm::vec3(1.0f));
+    // Queue text; nothing is drawn until flush()
+    // Takes any string type, including std::pmr::string built in a FrameArena or ScratchScope
+    void renderText(std::string_view text, float x, float y, float scale, const glm::vec3& color = glm::vec3(1.0f));
+
+    // Draws every glyph queued since the last flush with one upload and one
+    // draw call; call once per frame after the last renderText. Returns the
+    // number of draw calls issued (0 when nothing was queued)
+    uint32_t flush();
+    size_t getLastGlyphCount() const { return lastGlyphCount; }
     
     // Calculate the width of a text string
-    float getTextWidth(const std::string& text, float scale) const;
+    float getTextWidth(std::string_view text, float scale) const;
     
     // Update viewport dimensions
     void updateViewport(unsigned int width, unsigned int height);
 
 private:
-    // Render state
-    unsigned int VAO, VBO;
+    struct GlyphVertex {
+        float x, y;
+        uint16_t u, v;   // Atlas coordinates, unorm16
+        uint32_t color;  // RGBA8
+    };
+
+    // Quads of one string at the origin, without color
+    struct CachedLayout {
+        std::string text;
+        float scale = 0.0f;
+        std::vector<GlyphVertex> vertices;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    const CachedLayout& getLayout(std::string_view text, float scale);
+
+    // Render state; a frame's glyph quads are streamed as one ring range
+    unsigned int VAO;
+    std::unique_ptr<StreamingBuffer> vertexStream;
+    GLuint attributeBuffer;  // Buffer the VAO's attributes currently point at
     unsigned int shaderProgram;
     unsigned int fontTexture;
     
     // Text rendering shader uniform locations
-    int textColorLoc;
     int projectionLoc;
+    bool projectionDirty = true;  // Uploaded on the next flush after a resize
+
+    std::vector<GlyphVertex> pendingVertices;
+    size_t lastGlyphCount = 0;
+    std::unordered_map<uint64_t, CachedLayout> layoutCache;  // By hash of text and scale
+    uint64_t frame = 0;
     
     // Viewport dimensions
     unsigned int viewportWidth;
@@ -40,10 +75,14 @@ private:
     bool createShaders();
     void setupBuffers();
     void createFontTexture();
+    void bindAttributes();
     
     // Character dimensions
     static constexpr int CHAR_WIDTH = 8;
     static constexpr int CHAR_HEIGHT = 8;
     static constexpr int CHARS_PER_ROW = 16;
     static constexpr int CHARS_PER_COL = 16;
+    static constexpr GLsizeiptr VERTEX_SIZE = sizeof(GlyphVertex);
+    static constexpr GLsizeiptr STREAM_SIZE = 256 * 1024;
+    static constexpr size_t MAX_CACHED_LAYOUTS = 1024;  // Past this, layouts unused this frame are dropped
 }; 
\ No newline at end of file
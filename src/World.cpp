@@ -1,4 +1,7 @@
 #include "World.h"
+#include "MeshFile.h"
+#include "MeshImporter.h"
+#include <filesystem>
 
 World::World() : mainCamera() {}
 
@@ -34,6 +37,32 @@ void World::addMesh(const std::string& name, const Mesh& mesh) {
     meshes[name] = mesh;
 }
 
+bool World::loadMesh(const std::string& name, const std::string& path) {
+    std::string extension = std::filesystem::path(path).extension().string();
+    if (extension != ".mesh") {
+        std::vector<Mesh> imported;
+        if (!MeshImporter::importFile(path, imported)) {
+            return false;
+        }
+        // A model with several meshes adds them as name/meshName
+        for (Mesh& mesh : imported) {
+            std::string key = imported.size() == 1 ? name : name + "/" + mesh.getName();
+            mesh.setName(key);
+            meshes[key] = std::move(mesh);
+        }
+        return true;
+    }
+
+    MeshFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+    Mesh mesh = Mesh::fromView(file.getLod(0));
+    mesh.setName(name);
+    meshes[name] = std::move(mesh);
+    return true;
+}
+
 const Mesh* World::getMesh(const std::string& name) const {
     auto it = meshes.find(name);
     return it != meshes.end() ? &it->second : nullptr;
@@ -10,6 +10,8 @@
 #include "OpenGLWidget.h"
 #include "World.h"
 #include "Simulator.h"
+#include "EngineBackend.h"
+#include "Profiler.h"
 
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent)
@@ -156,13 +158,24 @@ void MainWindow::resetLayout()
 
 void MainWindow::updateSimulation()
 {
-    // Update the simulation
-    m_simulator.step(16.0f / 1000.0f); // Convert 16ms to seconds
-    
-    // Request a redraw of the OpenGL widget
-    if (glWidget) {
-        glWidget->update();
+    PerformanceMonitor::getInstance().startFrame();
+    {
+        PROFILE_SCOPE_CATEGORY("MainWindow::updateSimulation", "frame");
+
+        // Events posted from other threads, e.g. config reloads
+        EventSystem::getEngineEvents().dispatchDeferred();
+
+        // Update the simulation
+        PerformanceMonitor::getInstance().startOperation("physics_time");
+        m_simulator.step(16.0f / 1000.0f); // Convert 16ms to seconds
+        PerformanceMonitor::getInstance().endOperation("physics_time");
+        
+        // Request a redraw of the OpenGL widget
+        if (glWidget) {
+            glWidget->update();
+        }
     }
+    PerformanceMonitor::getInstance().endFrame();
 }
 
 void MainWindow::createMenus()
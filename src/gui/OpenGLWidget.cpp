@@ -5,10 +5,28 @@
 #include "OpenGLWidget.h"
 #include "World.h"
 #include "Simulator.h"
+#include "EngineBackend.h"
+#include "Profiler.h"
+#include "AllocationTracker.h"
+#include "FrameArena.h"
+#include "EngineConfig.h"
+#include "MeshCooker.h"
+#include "MeshFile.h"
+#include "DerivedAssetCache.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <iostream>
+#include <limits>
+
+namespace {
+float focalLengthPixels(int viewportHeight) {
+    return 0.5f * static_cast<float>(viewportHeight) / std::tan(glm::radians(45.0f) * 0.5f);
+}
+}
 
 OpenGLWidget::OpenGLWidget(World& world, Simulator& simulator, QWidget* parent)
     : QOpenGLWidget(parent)
@@ -20,12 +38,18 @@ OpenGLWidget::OpenGLWidget(World& world, Simulator& simulator, QWidget* parent)
     , m_cameraFront(0.0f, 0.0f, -1.0f)
     , m_cameraUp(0.0f, 1.0f, 0.0f)
     , m_projectionMatrix(glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 0.1f, 1000.0f))
-    , m_modelLoc(-1)
+    , m_focalLengthPixels(focalLengthPixels(600))
     , m_viewLoc(-1)
     , m_projLoc(-1)
-    , m_colorLoc(-1)
     , m_lightPosLoc(-1)
     , m_viewPosLoc(-1)
+    , m_meshOffsetLoc(-1)
+    , m_meshScaleLoc(-1)
+    , m_sphereLods{}
+    , m_lodErrorFactor{}
+    , m_lodFirst{}
+    , m_lodCount{}
+    , m_instanceOffset(0)
 {
     // Set the focus policy to accept key events
     setFocusPolicy(Qt::StrongFocus);
@@ -42,6 +66,7 @@ OpenGLWidget::~OpenGLWidget()
         glDeleteBuffers(1, &meshData.vbo);
         glDeleteBuffers(1, &meshData.ebo);
     }
+    m_instanceStream.reset();
     doneCurrent();
 }
 
@@ -66,24 +91,37 @@ void OpenGLWidget::initializeGL()
 
     const char* vertexShaderSource = R"(
 #version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
+layout (location = 0) in vec3 aPos;       // snorm16 within the mesh bounds
+layout (location = 1) in vec2 aNormal;    // Octahedral snorm16
 layout (location = 2) in vec2 aTexCoord;
+layout (location = 3) in vec4 aCenterRadius;  // Per instance
+layout (location = 4) in vec3 aColor;         // Per instance
 
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoord;
+out vec3 Color;
 
-uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
+uniform vec3 meshOffset;
+uniform vec3 meshScale;
+
+vec3 decodeNormal(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+    return normalize(n);
+}
 
 void main() {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    // Bodies are only translated and uniformly scaled, so normals pass through
+    FragPos = aCenterRadius.xyz + (meshOffset + aPos * meshScale) * aCenterRadius.w;
+    Normal = decodeNormal(aNormal);
     TexCoord = aTexCoord;
+    Color = aColor;
 
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
+    gl_Position = projection * view * vec4(FragPos, 1.0);
 }
 )";
 
@@ -94,12 +132,14 @@ out vec4 FragColor;
 in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoord;
+in vec3 Color;
 
-uniform vec3 color;
 uniform vec3 lightPos;
 uniform vec3 viewPos;
 
 void main() {
+    vec3 color = Color;
+
     // Ambient
     float ambientStrength = 0.1;
     vec3 ambient = ambientStrength * color;
@@ -138,22 +178,48 @@ void main() {
     }
 
     // Get uniform locations
-    m_modelLoc = m_program->uniformLocation("model");
     m_viewLoc = m_program->uniformLocation("view");
     m_projLoc = m_program->uniformLocation("projection");
-    m_colorLoc = m_program->uniformLocation("color");
     m_lightPosLoc = m_program->uniformLocation("lightPos");
     m_viewPosLoc = m_program->uniformLocation("viewPos");
-
-    // Setup mesh buffers for existing meshes
-    const Mesh* earthMesh = m_world.getMesh("earth");
-    if (earthMesh) {
-        setupMeshBuffers("earth", *earthMesh);
+    m_meshOffsetLoc = m_program->uniformLocation("meshOffset");
+    m_meshScaleLoc = m_program->uniformLocation("meshScale");
+
+    // Shared by every mesh VAO
+    size_t streamBytes = std::max<size_t>(EngineConfig::getInstance().getStreamingBufferSize(), 1) * 1024 * 1024;
+    m_instanceStream = std::make_unique<StreamingBuffer>(static_cast<GLsizeiptr>(streamBytes));
+
+    // Sphere LOD chain, finest first, cooked once into a cached mesh file and
+    // uploaded straight from the mapping afterwards
+    std::string key = DerivedAssetCache::KeyBuilder("sphere-lods")
+        .add(Mesh::SPHERE_GENERATOR_VERSION)
+        .add(MeshCooker::VERSION)
+        .add(MeshFile::VERSION)
+        .add(SPHERE_LOD_SEGMENTS)
+        .finish();
+    MeshFile sphereFile;
+    bool loaded = sphereFile.openCached(key, [] {
+        std::vector<CookedMesh> cooked;
+        std::vector<MeshFile::LodSource> sources;
+        cooked.reserve(LOD_COUNT);
+        for (int segments : SPHERE_LOD_SEGMENTS) {
+            cooked.push_back(MeshCooker::cook(Mesh::createSphere(1.0, segments)));
+            LOG_INFO("Cooked sphere, " + std::to_string(segments) + " segments: " + MeshCooker::describe(cooked.back()));
+            // Sagitta of the widest chord: the most a facet lies inside the true sphere
+            sources.push_back({&cooked.back(), 1.0f - std::cos(glm::pi<float>() / segments)});
+        }
+        return MeshFile::serialize(sources);
+    });
+    if (!loaded || sphereFile.getLodCount() != LOD_COUNT) {
+        LOG_ERROR("Failed to build the sphere LOD meshes; bodies are not drawn");
+        return;
     }
-    
-    const Mesh* moonMesh = m_world.getMesh("moon");
-    if (moonMesh) {
-        setupMeshBuffers("moon", *moonMesh);
+    for (size_t lod = 0; lod < LOD_COUNT; ++lod) {
+        std::string name = "sphere_lod" + std::to_string(lod);
+        setupMeshBuffers(name, sphereFile.getLod(lod));
+        m_sphereLods[lod] = &m_meshOpenGLData[name];
+        // Unit sphere, so the geometric error is already a fraction of the radius
+        m_lodErrorFactor[lod] = sphereFile.getGeometricError(lod);
     }
 }
 
@@ -175,7 +241,7 @@ bool OpenGLWidget::initializeGLAD()
     return gladLoadGLLoader((GLADloadproc)getProcAddress);
 }
 
-void OpenGLWidget::setupMeshBuffers(const std::string& name, const Mesh& mesh) {
+void OpenGLWidget::setupMeshBuffers(const std::string& name, const MeshView& mesh) {
     GLuint vao, vbo, ebo;
 
     glGenVertexArrays(1, &vao);
@@ -184,47 +250,23 @@ void OpenGLWidget::setupMeshBuffers(const std::string& name, const Mesh& mesh) {
 
     glBindVertexArray(vao);
 
-    // Get vertices and convert to OpenGL format
-    const auto& vertices = mesh.getVertices();
-    std::vector<float> vertexData;
-    for (const auto& vertex : vertices) {
-        // Position
-        vertexData.push_back(vertex.position.x);
-        vertexData.push_back(vertex.position.y);
-        vertexData.push_back(vertex.position.z);
-        // Normal
-        vertexData.push_back(vertex.normal.x);
-        vertexData.push_back(vertex.normal.y);
-        vertexData.push_back(vertex.normal.z);
-        // TexCoord
-        vertexData.push_back(vertex.texCoord.x);
-        vertexData.push_back(vertex.texCoord.y);
-    }
-
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertexData.size() * sizeof(float), vertexData.data(), GL_STATIC_DRAW);
-
-    // Get triangles and convert to indices
-    const auto& triangles = mesh.getTriangles();
-    std::vector<unsigned int> indices;
-    for (const auto& triangle : triangles) {
-        indices.push_back(triangle.v1);
-        indices.push_back(triangle.v2);
-        indices.push_back(triangle.v3);
-    }
-
+    glBufferData(GL_ARRAY_BUFFER, mesh.vertexCount * sizeof(PackedVertex), mesh.vertices, GL_STATIC_DRAW);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indexCount * mesh.indexSize, mesh.indices, GL_STATIC_DRAW);
 
-    // Vertex Positions
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-    // Vertex Normals
+    glVertexAttribPointer(0, 3, GL_SHORT, GL_TRUE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, position));
     glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-    // Vertex Texture Coords
+    glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, normal));
     glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
+    glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, texCoord));
+    // Per-instance center/radius and color; paintGL points them at each batch
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+    bindInstanceAttributes(0);
 
     glBindVertexArray(0);
 
@@ -232,7 +274,11 @@ void OpenGLWidget::setupMeshBuffers(const std::string& name, const Mesh& mesh) {
     data.vao = vao;
     data.vbo = vbo;
     data.ebo = ebo;
-    data.indexCount = static_cast<GLsizei>(indices.size());
+    data.indexCount = static_cast<GLsizei>(mesh.indexCount);
+    data.vertexCount = static_cast<GLsizei>(mesh.vertexCount);
+    data.indexType = mesh.indexSize == sizeof(uint16_t) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    data.positionOffset = mesh.positionOffset;
+    data.positionScale = mesh.positionScale;
     m_meshOpenGLData[name] = data;
 }
 
@@ -241,72 +287,194 @@ void OpenGLWidget::resizeGL(int w, int h)
     glViewport(0, 0, w, h);
     // Update projection matrix on resize
     m_projectionMatrix = glm::perspective(glm::radians(45.0f), (float)w / (float)h, 0.1f, 1000.0f);
+    m_focalLengthPixels = focalLengthPixels(h);
+}
+
+size_t OpenGLWidget::selectLod(float projectedRadius, size_t current) const
+{
+    const EngineSettings::Rendering& settings = EngineConfig::getInstance().getSettings().rendering;
+    // Coarsest LOD whose silhouette error stays under max_screen_error pixels.
+    // Dropping below the current LOD needs a hysteresis margin, so a body near
+    // a threshold does not flip between two LODs every frame
+    for (size_t lod = LOD_COUNT - 1; lod > 0; --lod) {
+        float threshold = settings.lodMaxScreenError;
+        if (lod > current) {
+            threshold *= 1.0f - settings.lodHysteresis;
+        }
+        if (projectedRadius * m_lodErrorFactor[lod] <= threshold) {
+            return lod;
+        }
+    }
+    return 0;
+}
+
+OpenGLWidget::CullCounts OpenGLWidget::uploadInstances(const glm::mat4& view)
+{
+    PROFILE_SCOPE_CATEGORY("OpenGLWidget::uploadInstances", "render");
+    const EngineSettings& settings = EngineConfig::getInstance().getSettings();
+    size_t bodyCount = m_world.getBodyCount();
+    m_bodySpheres.resize(bodyCount);
+    for (size_t i = 0; i < bodyCount; ++i) {
+        const Body& body = m_world.getBody(i);
+        m_bodySpheres.x[i] = static_cast<float>(body.position.x);
+        m_bodySpheres.y[i] = static_cast<float>(body.position.y);
+        m_bodySpheres.z[i] = static_cast<float>(body.position.z);
+        m_bodySpheres.radius[i] = body.radius;
+    }
+
+    // The visibility flags and instance list only live for this frame
+    std::pmr::memory_resource* frameMemory = FrameArena::getInstance().resource();
+    const EngineSettings::Optimization& culling = settings.optimization;
+    ThreadPool& pool = ThreadPool::getRenderPool();
+    std::pmr::vector<uint8_t> visible(bodyCount, frameMemory);
+    CullCounts counts;
+    counts.visible = bodyCount;
+    if (culling.cullingEnabled && culling.frustumCulling) {
+        Frustum frustum = Frustum::fromViewProjection(m_projectionMatrix * view);
+        counts.visible = frustum.cullSpheresParallel(m_bodySpheres, visible.data(), pool);
+    } else {
+        std::fill(visible.begin(), visible.end(), uint8_t(1));
+    }
+    if (culling.cullingEnabled && culling.occlusionCulling) {
+        m_occlusionCuller.build(view, m_projectionMatrix, m_bodySpheres, visible.data(), pool);
+        counts.occluded = m_occlusionCuller.cullParallel(m_bodySpheres, visible.data(), pool);
+        counts.visible -= counts.occluded;
+    }
+    size_t visibleCount = counts.visible;
+
+    bool lodEnabled = settings.rendering.lodEnabled;
+    m_bodyLods.resize(bodyCount, 0);
+    m_lodCount.fill(0);
+    for (size_t i = 0; i < bodyCount; ++i) {
+        if (!visible[i]) {
+            continue;  // Keeps its last LOD for hysteresis when it comes back into view
+        }
+        size_t lod = 0;
+        if (lodEnabled) {
+            glm::vec3 center(m_bodySpheres.x[i], m_bodySpheres.y[i], m_bodySpheres.z[i]);
+            float radius = m_bodySpheres.radius[i];
+            float distance = glm::length(center - m_cameraPos);
+            // Inside or touching the sphere keeps full detail
+            float projectedRadius = distance > radius
+                ? m_focalLengthPixels * radius / distance
+                : std::numeric_limits<float>::max();
+            lod = selectLod(projectedRadius, m_bodyLods[i]);
+        }
+        m_bodyLods[i] = static_cast<uint8_t>(lod);
+        m_lodCount[lod]++;
+    }
+
+    // Counting sort by LOD so each LOD is one contiguous instanced draw
+    size_t next = 0;
+    for (size_t lod = 0; lod < LOD_COUNT; ++lod) {
+        m_lodFirst[lod] = next;
+        next += m_lodCount[lod];
+    }
+    std::array<size_t, LOD_COUNT> cursor = m_lodFirst;
+    std::pmr::vector<InstanceData> instances(visibleCount, frameMemory);
+    for (size_t i = 0; i < bodyCount; ++i) {
+        if (!visible[i]) {
+            continue;
+        }
+        const Body& body = m_world.getBody(i);
+        InstanceData& instance = instances[cursor[m_bodyLods[i]]++];
+        instance.centerRadius = glm::vec4(body.position.x, body.position.y, body.position.z, body.radius);
+        instance.color = glm::vec4(body.color.x, body.color.y, body.color.z, 1.0f);
+    }
+
+    if (visibleCount > 0) {
+        m_instanceOffset = m_instanceStream->upload(instances.data(),
+                                                    static_cast<GLsizeiptr>(visibleCount * sizeof(InstanceData)));
+    }
+    return counts;
+}
+
+void OpenGLWidget::bindInstanceAttributes(size_t firstInstance)
+{
+    // Without base-instance draws (GL 4.2), a batch starts where its attributes point
+    const char* base = reinterpret_cast<const char*>(m_instanceOffset + firstInstance * sizeof(InstanceData));
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceStream->buffer());
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                          base + offsetof(InstanceData, centerRadius));
+    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                          base + offsetof(InstanceData, color));
+}
+
+uint32_t OpenGLWidget::drawBodies(const MeshOpenGLData* mesh, size_t first, size_t count, bool instanced, size_t maxBatch)
+{
+    if (!mesh || count == 0) {
+        return 0;
+    }
+
+    uint32_t drawCalls = 0;
+    glBindVertexArray(mesh->vao);
+    glUniform3fv(m_meshOffsetLoc, 1, glm::value_ptr(mesh->positionOffset));
+    glUniform3fv(m_meshScaleLoc, 1, glm::value_ptr(mesh->positionScale));
+    if (instanced) {
+        for (size_t offset = 0; offset < count; offset += maxBatch) {
+            size_t batch = std::min(maxBatch, count - offset);
+            bindInstanceAttributes(first + offset);
+            glDrawElementsInstanced(GL_TRIANGLES, mesh->indexCount, mesh->indexType, 0, static_cast<GLsizei>(batch));
+            drawCalls++;
+        }
+    } else {
+        // A non-instanced draw reads instanced attributes from instance 0
+        for (size_t i = first; i < first + count; ++i) {
+            bindInstanceAttributes(i);
+            glDrawElements(GL_TRIANGLES, mesh->indexCount, mesh->indexType, 0);
+            drawCalls++;
+        }
+    }
+    glBindVertexArray(0);
+    return drawCalls;
 }
 
 void OpenGLWidget::paintGL()
 {
+    PROFILE_SCOPE_CATEGORY("OpenGLWidget::paintGL", "render");
+    AllocationScope allocations(AllocationTag::Render, true);
+    PerformanceMonitor& monitor = PerformanceMonitor::getInstance();
+    monitor.startOperation("render_time");
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     // Use shader program
     if (m_program && m_program->bind()) {
-        // Set view and projection matrices
+        // CPU cost of issuing the frame's GL commands, measured per path
+        monitor.startOperation("render_submit");
+
         glm::mat4 view = glm::lookAt(m_cameraPos, m_cameraPos + m_cameraFront, m_cameraUp);
-        
-        // Convert GLM matrices to QMatrix4x4
-        QMatrix4x4 viewMatrix;
-        QMatrix4x4 projMatrix;
-        for(int i = 0; i < 4; i++) {
-            for(int j = 0; j < 4; j++) {
-                viewMatrix(i, j) = view[i][j];
-                projMatrix(i, j) = m_projectionMatrix[i][j];
-            }
-        }
-        
-        m_program->setUniformValue("view", viewMatrix);
-        m_program->setUniformValue("projection", projMatrix);
-        
-        // Convert GLM vec3 to QVector3D for viewPos
-        QVector3D viewPosVec(m_cameraPos.x, m_cameraPos.y, m_cameraPos.z);
-        m_program->setUniformValue("viewPos", viewPosVec);
-
-        // Set light position (example light position)
-        QVector3D lightPosVec(10.0f, 10.0f, 10.0f);
-        m_program->setUniformValue("lightPos", lightPosVec);
-
-        // Render each body with its mesh
-        for (size_t i = 0; i < m_world.getBodyCount(); ++i) {
-            const Body& body = m_world.getBody(i);
-            std::string meshName = (i == 0) ? "earth" : "moon";
-            auto it = m_meshOpenGLData.find(meshName);
-
-            if (it != m_meshOpenGLData.end()) {
-                const MeshOpenGLData& meshData = it->second;
-
-                // Create model matrix
-                glm::mat4 model = glm::mat4(1.0f);
-                model = glm::translate(model, glm::vec3(body.position.x, body.position.y, body.position.z));
-
-                // Convert GLM model matrix to QMatrix4x4
-                QMatrix4x4 modelMatrix;
-                for(int i = 0; i < 4; i++) {
-                    for(int j = 0; j < 4; j++) {
-                        modelMatrix(i, j) = model[i][j];
-                    }
-                }
-                m_program->setUniformValue("model", modelMatrix);
-
-                QVector3D colorVec(1.0f, 1.0f, 1.0f);
-                m_program->setUniformValue("color", colorVec);
-
-                // Draw mesh
-                glBindVertexArray(meshData.vao);
-                glDrawElements(GL_TRIANGLES, meshData.indexCount, GL_UNSIGNED_INT, 0);
-                glBindVertexArray(0);
-            } else {
-                qDebug() << "Mesh data not found for:" << QString::fromStdString(meshName);
+        glUniformMatrix4fv(m_viewLoc, 1, GL_FALSE, glm::value_ptr(view));
+        glUniformMatrix4fv(m_projLoc, 1, GL_FALSE, glm::value_ptr(m_projectionMatrix));
+        glUniform3f(m_viewPosLoc, m_cameraPos.x, m_cameraPos.y, m_cameraPos.z);
+        glUniform3f(m_lightPosLoc, 10.0f, 10.0f, 10.0f);
+
+        // optimization.batching.enabled selects one instanced draw per LOD
+        // (split at max_batch_size) over one draw per body
+        const EngineSettings::Optimization& settings = EngineConfig::getInstance().getSettings().optimization;
+        size_t maxBatch = static_cast<size_t>(std::max(1, settings.maxBatchSize));
+
+        PerformanceMonitor::RenderStats stats;
+        CullCounts counts = uploadInstances(view);
+        stats.visibleObjects = counts.visible;
+        stats.occludedObjects = counts.occluded;
+        stats.culledObjects = m_world.getBodyCount() - counts.visible - counts.occluded;
+        const MeshOpenGLData* fullDetail = m_sphereLods[0];
+        for (size_t lod = 0; lod < LOD_COUNT; ++lod) {
+            const MeshOpenGLData* mesh = m_sphereLods[lod];
+            size_t count = m_lodCount[lod];
+            if (!mesh || count == 0) {
+                continue;
             }
+            stats.drawCalls += drawBodies(mesh, m_lodFirst[lod], count, settings.batchingEnabled, maxBatch);
+            stats.triangles += static_cast<uint64_t>(mesh->indexCount / 3) * count;
+            stats.vertices += static_cast<uint64_t>(mesh->vertexCount) * count;
+            stats.fullDetailTriangles += static_cast<uint64_t>(fullDetail->indexCount / 3) * count;
+            stats.fullDetailVertices += static_cast<uint64_t>(fullDetail->vertexCount) * count;
         }
+        m_instanceStream->endFrame();
+        monitor.addRenderStats(stats);
+        monitor.endOperation("render_submit");
 
         m_program->release();
     }
@@ -315,6 +483,8 @@ void OpenGLWidget::paintGL()
     // You'll need access to your Grid class and its rendering logic
     // For example:
     // grid->render(view, projection, cameraPos);
+
+    monitor.endOperation("render_time");
 }
 
 void OpenGLWidget::setCameraPosition(const glm::vec3& pos)
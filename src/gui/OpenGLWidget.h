@@ -14,9 +14,15 @@
 #include <QOpenGLContext>
 #include <QMatrix4x4>
 #include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
 #include "World.h"
 #include "Simulator.h"
 #include "Mesh.h"
+#include "StreamingBuffer.h"
+#include "Frustum.h"
+#include "OcclusionCuller.h"
 
 class OpenGLWidget : public QOpenGLWidget, protected QOpenGLFunctions {
     Q_OBJECT
@@ -35,8 +41,22 @@ protected:
     void paintGL() override;
 
 private:
-    void setupMeshBuffers(const std::string& name, const Mesh& mesh);
+    struct MeshOpenGLData;
+
+    // Uploads cooked data as is (MeshCooker layout)
+    void setupMeshBuffers(const std::string& name, const MeshView& mesh);
     bool initializeGLAD();
+    struct CullCounts {
+        size_t visible = 0;
+        size_t occluded = 0;  // Inside the frustum but hidden behind an occluder
+    };
+    // Culls the bodies, picks a LOD for each visible one, then streams the
+    // visible instances grouped by LOD
+    CullCounts uploadInstances(const glm::mat4& view);
+    size_t selectLod(float projectedRadius, size_t current) const;
+    void bindInstanceAttributes(size_t firstInstance);
+    // Draws bodies [first, first + count) with one mesh; returns the draw calls issued
+    uint32_t drawBodies(const MeshOpenGLData* mesh, size_t first, size_t count, bool instanced, size_t maxBatch);
 
     // World and simulation
     World& m_world;
@@ -51,14 +71,15 @@ private:
     glm::vec3 m_cameraFront;
     glm::vec3 m_cameraUp;
     glm::mat4 m_projectionMatrix;
+    float m_focalLengthPixels;  // Projected size of one world unit at distance one
 
     // Shader uniform locations
-    int m_modelLoc;
     int m_viewLoc;
     int m_projLoc;
-    int m_colorLoc;
     int m_lightPosLoc;
     int m_viewPosLoc;
+    int m_meshOffsetLoc;
+    int m_meshScaleLoc;
 
     // Mesh data
     struct MeshOpenGLData {
@@ -66,6 +87,33 @@ private:
         GLuint vbo;
         GLuint ebo;
         GLsizei indexCount;
+        GLsizei vertexCount;
+        GLenum indexType;
+        glm::vec3 positionOffset;  // Decodes the snorm16 positions (MeshCooker)
+        glm::vec3 positionScale;
     };
     std::map<std::string, MeshOpenGLData> m_meshOpenGLData;
+
+    // Bodies are unit spheres scaled by their radius, drawn from a LOD chain
+    // chosen by projected screen-space error (rendering.lod)
+    static constexpr std::array<int, 4> SPHERE_LOD_SEGMENTS = {64, 32, 16, 8};
+    static constexpr size_t LOD_COUNT = SPHERE_LOD_SEGMENTS.size();
+    std::array<const MeshOpenGLData*, LOD_COUNT> m_sphereLods;
+    std::array<float, LOD_COUNT> m_lodErrorFactor;  // Max chord error as a fraction of the radius
+    std::vector<uint8_t> m_bodyLods;                // Last frame's LOD per body, for hysteresis
+    std::array<size_t, LOD_COUNT> m_lodFirst;       // This frame's instances, grouped by LOD
+    std::array<size_t, LOD_COUNT> m_lodCount;
+
+    // Body bounding spheres gathered for culling (optimization.culling)
+    SphereArrays m_bodySpheres;
+    OcclusionCuller m_occlusionCuller;
+
+    // Per-body attributes, rebuilt in the frame arena and streamed once per
+    // frame. Each mesh VAO reads them as instanced attributes 3 and 4
+    struct InstanceData {
+        glm::vec4 centerRadius;  // xyz world position, w radius
+        glm::vec4 color;         // rgb, a unused
+    };
+    std::unique_ptr<StreamingBuffer> m_instanceStream;
+    GLintptr m_instanceOffset;  // This frame's instances in m_instanceStream
 }; 
\ No newline at end of file
@@ -6,6 +6,10 @@
 #include "World.h"
 #include "Simulator.h"
 #include "ResourceManager.h"
+#include "EngineConfig.h"
+#include "Profiler.h"
+#include "PerfCounters.h"
+#include "SamplingProfiler.h"
 #include "gui/MainWindow.h"
 #include <QApplication>
 
@@ -38,6 +42,32 @@ int main(int argc, char* argv[]) {
     World world;
     Simulator simulator(world);
 
+    EngineConfig& config = EngineConfig::getInstance();
+    // Settings read per use pick up a reload by themselves; these are cached in flags
+    EventSystem::getEngineEvents().subscribe<ConfigChangedEvent>([](const ConfigChangedEvent& event) {
+        Profiler::getInstance().setEnabled(event.current->debug.profilingEnabled);
+        PerfCounters::getInstance().setEnabled(event.current->debug.hardwareCounters);
+    });
+    if (config.isSamplingProfilerEnabled()) {
+        SamplingProfiler::getInstance().start(config.getSamplingRate());
+    }
+
     // Enter Qt event loop
-    return app.exec();
+    int result = app.exec();
+
+    // Folded stacks for flamegraph.pl or speedscope
+    if (SamplingProfiler::getInstance().isRunning()) {
+        SamplingProfiler::getInstance().stop();
+        SamplingProfiler::getInstance().writeFoldedStacks(config.getSamplingOutput());
+    }
+
+    // Timeline of the session for chrome://tracing or ui.perfetto.dev
+    std::string traceFile = config.getProfilingTraceFile();
+    if (Profiler::getInstance().isEnabled() && !traceFile.empty()) {
+        Profiler::getInstance().exportChromeTrace(traceFile);
+    }
+    if (Profiler::getInstance().isEnabled()) {
+        LOG_INFO("Performance report:\n" + PerformanceMonitor::getInstance().getReport());
+    }
+    return result;
 } 
\ No newline at end of file
@@ -0,0 +1,41 @@
+// Packs asset directories into a single AssetPack file.
+//
+// Usage: asset-packer <root> <output.pak> <dir> [dir...]
+// Paths inside the pack are relative to <root>, matching what
+// ResourceManager::getResourcePath expects (e.g. "shaders/grid.vert").
+
+#include "AssetPack.h"
+#include <filesystem>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        std::cerr << "Usage: asset-packer <root> <output.pak> <dir> [dir...]" << std::endl;
+        return 1;
+    }
+
+    fs::path root = argv[1];
+    std::vector<std::pair<std::string, std::string>> files;
+    for (int i = 3; i < argc; ++i) {
+        fs::path directory = root / argv[i];
+        if (!fs::is_directory(directory)) {
+            std::cerr << "Not a directory: " << directory.string() << std::endl;
+            return 1;
+        }
+        for (const auto& entry : fs::recursive_directory_iterator(directory)) {
+            if (entry.is_regular_file()) {
+                std::string packPath = fs::relative(entry.path(), root).generic_string();
+                files.emplace_back(packPath, entry.path().string());
+            }
+        }
+    }
+
+    if (!AssetPack::build(argv[2], files)) {
+        std::cerr << "Failed to write asset pack: " << argv[2] << std::endl;
+        return 1;
+    }
+    std::cout << "Packed " << files.size() << " files into " << argv[2] << std::endl;
+    return 0;
+}
@@ -0,0 +1,155 @@
+// Cooks meshes into MeshFile containers (.mesh) and inspects them.
+//
+// Usage:
+//   mesh-converter sphere <output.mesh> <segments> [segments...]
+//   mesh-converter cube <output.mesh> <size>
+//   mesh-converter mesh <output.mesh> <lod.bin>[:error] [<lod.bin>[:error]...]
+//   mesh-converter import <output.mesh> <model>[:error] [<model>[:error]...]
+//   mesh-converter info <input.mesh>
+// Each argument after the output is one LOD, finest first. "mesh" inputs are
+// Mesh::serialize() blobs, "import" inputs OBJ or glTF models whose meshes are
+// merged into one; error is the LOD's geometric error in mesh units.
+
+#include "MeshFile.h"
+#include "MeshCooker.h"
+#include "MeshImporter.h"
+#include "Mesh.h"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+int usage() {
+    std::cerr << "Usage:\n"
+              << "  mesh-converter sphere <output.mesh> <segments> [segments...]\n"
+              << "  mesh-converter cube <output.mesh> <size>\n"
+              << "  mesh-converter mesh <output.mesh> <lod.bin>[:error] [<lod.bin>[:error]...]\n"
+              << "  mesh-converter import <output.mesh> <model>[:error] [<model>[:error]...]\n"
+              << "  mesh-converter info <input.mesh>" << std::endl;
+    return 1;
+}
+
+// Splits "path:error"; a colon followed by nothing, or a drive letter, stays in the path
+void splitLodArgument(const std::string& argument, std::string& path, float& error) {
+    size_t colon = argument.rfind(':');
+    path = argument;
+    error = 0.0f;
+    if (colon != std::string::npos && colon > 1 && colon + 1 < argument.size()) {
+        path = argument.substr(0, colon);
+        error = std::strtof(argument.c_str() + colon + 1, nullptr);
+    }
+}
+
+Mesh mergeMeshes(const std::vector<Mesh>& meshes) {
+    Mesh merged;
+    merged.setName(meshes.front().getName());
+    for (const Mesh& mesh : meshes) {
+        int base = static_cast<int>(merged.getVertices().size());
+        for (const Vertex& vertex : mesh.getVertices()) {
+            merged.addVertex(vertex);
+        }
+        for (const Triangle& triangle : mesh.getTriangles()) {
+            merged.addTriangle({triangle.v1 + base, triangle.v2 + base, triangle.v3 + base});
+        }
+    }
+    return merged;
+}
+
+int printInfo(const std::string& path) {
+    MeshFile file;
+    if (!file.open(path)) {
+        std::cerr << "Failed to open mesh file: " << path << std::endl;
+        return 1;
+    }
+    glm::vec3 low = file.getBoundsMin();
+    glm::vec3 high = file.getBoundsMax();
+    std::cout << path << ": " << file.getLodCount() << " LODs, bounds (" << low.x << ", " << low.y << ", " << low.z
+              << ") - (" << high.x << ", " << high.y << ", " << high.z << "), radius " << file.getBoundsRadius()
+              << std::endl;
+    for (size_t lod = 0; lod < file.getLodCount(); ++lod) {
+        MeshView view = file.getLod(lod);
+        std::cout << "  LOD " << lod << ": " << view.vertexCount << " vertices, " << view.indexCount / 3
+                  << " triangles, " << view.indexSize * 8 << "-bit indices, error " << file.getGeometricError(lod)
+                  << std::endl;
+    }
+    return 0;
+}
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        return usage();
+    }
+    std::string command = argv[1];
+    if (command == "info") {
+        return printInfo(argv[2]);
+    }
+    if (argc < 4) {
+        return usage();
+    }
+
+    std::string output = argv[2];
+    std::vector<Mesh> meshes;
+    std::vector<float> errors;
+    if (command == "sphere") {
+        for (int i = 3; i < argc; ++i) {
+            int segments = std::atoi(argv[i]);
+            if (segments < 3) {
+                std::cerr << "Invalid segment count: " << argv[i] << std::endl;
+                return 1;
+            }
+            meshes.push_back(Mesh::createSphere(1.0, segments));
+            errors.push_back(1.0f - std::cos(3.14159265f / segments));
+        }
+    } else if (command == "cube") {
+        meshes.push_back(Mesh::createCube(std::atof(argv[3])));
+        errors.push_back(0.0f);
+    } else if (command == "mesh") {
+        for (int i = 3; i < argc; ++i) {
+            std::string path;
+            float error;
+            splitLodArgument(argv[i], path, error);
+            std::vector<uint8_t> bytes;
+            Mesh mesh;
+            if (!FileSystem::getInstance().loadFile(path, bytes) ||
+                !Mesh::deserialize(std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()), mesh)) {
+                std::cerr << "Failed to read mesh: " << path << std::endl;
+                return 1;
+            }
+            meshes.push_back(std::move(mesh));
+            errors.push_back(error);
+        }
+    } else if (command == "import") {
+        for (int i = 3; i < argc; ++i) {
+            std::string path;
+            float error;
+            splitLodArgument(argv[i], path, error);
+            std::vector<Mesh> imported;
+            MeshImporter::ImportStats stats;
+            if (!MeshImporter::importFile(path, imported, &stats)) {
+                std::cerr << "Failed to import model: " << path << std::endl;
+                return 1;
+            }
+            std::cout << path << ": " << stats.vertices << " vertices, " << stats.triangles << " triangles, "
+                      << stats.parseMs + stats.buildMs << " ms (" << stats.throughputMBps() << " MB/s)" << std::endl;
+            meshes.push_back(imported.size() == 1 ? std::move(imported.front()) : mergeMeshes(imported));
+            errors.push_back(error);
+        }
+    } else {
+        return usage();
+    }
+
+    std::vector<CookedMesh> cooked;
+    std::vector<MeshFile::LodSource> sources;
+    cooked.reserve(meshes.size());
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        cooked.push_back(MeshCooker::cook(meshes[i]));
+        std::cout << "LOD " << i << ": " << MeshCooker::describe(cooked.back()) << std::endl;
+        sources.push_back({&cooked.back(), errors[i]});
+    }
+    if (!MeshFile::write(output, sources)) {
+        std::cerr << "Failed to write mesh file: " << output << std::endl;
+        return 1;
+    }
+    return printInfo(output);
+}